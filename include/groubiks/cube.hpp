@@ -2,6 +2,11 @@
 #ifndef GROUBIKS_CUBE_HPP
 #define GROUBIKS_CUBE_HPP
 
+#include <cstdint>
+#include <cstddef>
+#include <functional>
+#include <ostream>
+
 namespace groubiks {
     /*
     * the following colors are opposed in a regular cube:
@@ -21,25 +26,154 @@ namespace groubiks {
     /*
      * a cube consists of 6 center-pieces, 12 edges and 8 vertices.
      * to fully encode a cube, we only save 20 numbers that determine
-     * the exact state of the cube by enumerating all edges and vertices.
+     * the exact state of the cube by enumerating all edges and vertices,
+     * plus the orientation (twist/flip) of every single piece.
      *
      * the state of the cube is determined as follows:
+     * slot i holds the piece that is currently located at position i.
+     * vertex-slots are numbered URF, UFL, ULB, UBR, DFR, DLF, DBL, DRB,
+     * edge-slots are numbered UR, UF, UL, UB, DR, DF, DL, DB, FR, FL, BL, BR.
+     * a vertex-twist (0..2) counts the clockwise turns of the piece's U/D-sticker
+     * away from the U/D-face, an edge-flip (0..1) is set if the piece sits in its
+     * slot the other way around.
      *
-     * the default, solved cube is therefore encoded via two sorted arrays:
+     * the default, solved cube is therefore encoded via two sorted arrays
+     * with all orientations set to zero:
      * vertices: [ 0, 1, 2, ..., 7 ]
-     * edges:    [ 0, 1, 2, ..., 11 ] 
+     * edges:    [ 0, 1, 2, ..., 11 ]
+     *
+     * the arrays are bit-packed into two 64-bit words (16 bytes in total),
+     * so a cube fits into a single sse-register and can be copied,
+     * compared and hashed like an integer:
+     * vertex_bits: byte i holds vertex (bits 0..3) | twist << 4.
+     * edge_bits:   bits [5i, 5i+5) hold edge (bits 0..3) | flip << 4.
+     *              bits 60..63 are always zero.
      */
-    class cube {
+    class alignas(16) cube {
     public:
         using vertex_type = int;
         using edge_type = int;
+        using orientation_type = int;
+        using word_type = std::uint64_t;
+
+        static constexpr int num_vertices = 8;
+        static constexpr int num_edges = 12;
+
+        static constexpr int vertex_field_bits = 8;
+        static constexpr int edge_field_bits = 5;
+        static constexpr word_type vertex_field_mask = 0x3f;
+        static constexpr word_type edge_field_mask = 0x1f;
+        static constexpr word_type piece_mask = 0x0f;
+        static constexpr int orientation_shift = 4;
+
+        /*
+         * the unpacked cube: one int per piece and orientation.
+         * this is the layout a cube was stored in before packing,
+         * extended by the orientations of the pieces.
+         */
+        struct layout {
+            vertex_type vertices[num_vertices];
+            edge_type edges[num_edges];
+            orientation_type vertex_twists[num_vertices];
+            orientation_type edge_flips[num_edges];
+        };
+
+        word_type vertex_bits = solved_vertex_bits();
+        word_type edge_bits = solved_edge_bits();
+
+        /* piece-accessors. slots are not range-checked. */
+        constexpr vertex_type vertex(int slot) const
+        { return (vertex_bits >> (slot * vertex_field_bits)) & piece_mask; }
+        constexpr orientation_type vertex_twist(int slot) const
+        { return (vertex_bits >> (slot * vertex_field_bits + orientation_shift)) & 0x3; }
+        constexpr edge_type edge(int slot) const
+        { return (edge_bits >> (slot * edge_field_bits)) & piece_mask; }
+        constexpr orientation_type edge_flip(int slot) const
+        { return (edge_bits >> (slot * edge_field_bits + orientation_shift)) & 0x1; }
+
+        constexpr void set_vertex(int slot, vertex_type v, orientation_type twist) {
+            const int shift = slot * vertex_field_bits;
+            vertex_bits &= ~(vertex_field_mask << shift);
+            vertex_bits |= (word_type(v) | word_type(twist) << orientation_shift) << shift;
+        }
+        constexpr void set_edge(int slot, edge_type e, orientation_type flip) {
+            const int shift = slot * edge_field_bits;
+            edge_bits &= ~(edge_field_mask << shift);
+            edge_bits |= (word_type(e) | word_type(flip) << orientation_shift) << shift;
+        }
 
-        vertex_type vertices[8];
-        edge_type edges[12];
+        static constexpr word_type solved_vertex_bits() {
+            word_type res = 0;
+            for (int i = 0; i < num_vertices; ++i)
+            { res |= word_type(i) << (i * vertex_field_bits); }
+            return res;
+        }
+        static constexpr word_type solved_edge_bits() {
+            word_type res = 0;
+            for (int i = 0; i < num_edges; ++i)
+            { res |= word_type(i) << (i * edge_field_bits); }
+            return res;
+        }
 
-        static constexpr cube get_solved();
+        static constexpr cube get_solved()
+        { return cube{ solved_vertex_bits(), solved_edge_bits() }; }
+
+        /**
+         * @brief conversion from and to the unpacked layout.
+         *        no validation is performed, pieces and orientations are expected to be in range.
+         */
+        static constexpr cube pack(const layout& l) {
+            cube res{ 0, 0 };
+            for (int i = 0; i < num_vertices; ++i)
+            { res.set_vertex(i, l.vertices[i], l.vertex_twists[i]); }
+            for (int i = 0; i < num_edges; ++i)
+            { res.set_edge(i, l.edges[i], l.edge_flips[i]); }
+            return res;
+        }
+        constexpr layout unpack() const {
+            layout res{};
+            for (int i = 0; i < num_vertices; ++i) {
+                res.vertices[i] = vertex(i);
+                res.vertex_twists[i] = vertex_twist(i);
+            }
+            for (int i = 0; i < num_edges; ++i) {
+                res.edges[i] = edge(i);
+                res.edge_flips[i] = edge_flip(i);
+            }
+            return res;
+        }
+
+        constexpr bool is_solved() const
+        { return *this == get_solved(); }
+
+        /**
+         * @brief multiply-shift hash over both words.
+         */
+        constexpr std::size_t hash() const {
+            word_type h = vertex_bits * 0x9e3779b97f4a7c15ull;
+            h ^= (edge_bits * 0xc2b2ae3d27d4eb4full) >> 3 | (edge_bits * 0xc2b2ae3d27d4eb4full) << 61;
+            h ^= h >> 29;
+            h *= 0xbf58476d1ce4e5b9ull;
+            return std::size_t(h ^ (h >> 32));
+        }
+
+        friend constexpr bool operator==(const cube&, const cube&) = default;
     };
 
+    static_assert(sizeof(cube) == 16, "a cube is expected to fit into 16 bytes");
+
+    std::ostream& operator<<(std::ostream& os, const cube& c);
+
+#ifdef BUILD_TESTS
+    int cube_test(std::ostream& os);
+#endif
+
 }
 
-#endif
\ No newline at end of file
+template<>
+struct std::hash<groubiks::cube> {
+    std::size_t operator()(const groubiks::cube& c) const noexcept
+    { return c.hash(); }
+};
+
+#endif
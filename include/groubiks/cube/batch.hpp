@@ -0,0 +1,96 @@
+
+#ifndef GROUBIKS_CUBE_BATCH_HPP
+#define GROUBIKS_CUBE_BATCH_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <span>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file batch.hpp
+ * @brief structure-of-arrays container for many cubes.
+ * @details a batch stores one byte-array per piece-slot (8 vertex- and 12 edge-slots).
+ *          byte k of the array of slot i holds the piece of cube k at slot i,
+ *          in the same byte-encoding as cube::vertex_bits (piece | orientation << 4).
+ *
+ *          a move only permutes the slots of *all* cubes the same way, so the
+ *          permutation is done by renaming the arrays (no data is touched) and
+ *          only the arrays whose orientation changes get one vectorized pass
+ *          (32 cubes per avx2-instruction).
+ *          a whole sequence collapses into a single such transform, so
+ *          apply_sequence() touches every array at most once, regardless of its length.
+ */
+
+namespace groubiks {
+
+    class cube_batch {
+    public:
+        using byte_type = std::uint8_t;
+
+        /* arrays are padded to and aligned on this many bytes. */
+        static constexpr std::size_t alignment = 32;
+        static constexpr int num_slots = cube::num_vertices + cube::num_edges;
+
+        /**
+         * @brief creates a batch of `size` solved cubes.
+         */
+        explicit cube_batch(std::size_t size = 0);
+        cube_batch(const cube_batch& other);
+        cube_batch(cube_batch&& other) noexcept = default;
+        cube_batch& operator=(const cube_batch& other);
+        cube_batch& operator=(cube_batch&& other) noexcept = default;
+        ~cube_batch() = default;
+
+        std::size_t size() const { return m_size; }
+        /* the length of every slot-array, i.e. size() rounded up to the alignment. */
+        std::size_t stride() const { return m_stride; }
+
+        cube get(std::size_t idx) const;
+        void set(std::size_t idx, const cube& c);
+
+        byte_type* vertex_slot(int slot)
+        { return block(m_vertex_blocks[slot]); }
+        const byte_type* vertex_slot(int slot) const
+        { return block(m_vertex_blocks[slot]); }
+        byte_type* edge_slot(int slot)
+        { return block(m_edge_blocks[slot]); }
+        const byte_type* edge_slot(int slot) const
+        { return block(m_edge_blocks[slot]); }
+
+        /**
+         * @brief applies the permutation and orientation-changes of `t` to every cube,
+         *        i.e. cube k becomes multiply(cube k, t).
+         */
+        void transform(const cube& t);
+
+    private:
+        struct aligned_delete {
+            void operator()(byte_type* p) const
+            { ::operator delete[](p, std::align_val_t(alignment)); }
+        };
+
+        byte_type* block(int b) const
+        { return m_data.get() + std::size_t(b) * m_stride; }
+
+        std::size_t m_size = 0;
+        std::size_t m_stride = 0;
+        std::unique_ptr<byte_type[], aligned_delete> m_data;
+        /* the array currently holding each slot. */
+        std::array<std::uint8_t, cube::num_vertices> m_vertex_blocks{};
+        std::array<std::uint8_t, cube::num_edges> m_edge_blocks{};
+    };
+
+    void apply_move(cube_batch& batch, move_t m);
+    void apply_sequence(cube_batch& batch, std::span<const move_t> seq);
+
+#ifdef BUILD_TESTS
+    int batch_test(std::ostream& os);
+#endif
+
+}
+
+#endif
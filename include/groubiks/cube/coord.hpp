@@ -0,0 +1,310 @@
+
+#ifndef GROUBIKS_CUBE_COORD_HPP
+#define GROUBIKS_CUBE_COORD_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <groubiks/cube.hpp>
+
+/**
+ * @file coord.hpp
+ * @brief dense integer coordinates of cube-states (ranking) and their inverses (unranking).
+ * @details every coordinate maps one aspect of a cube to 0..count-1, with the solved
+ *          cube always at 0, so coordinates can index plain arrays instead of hash-maps.
+ *          rank-functions read a cube, set-functions (unranking) overwrite only
+ *          the aspect they describe and leave the rest of the cube as it is.
+ *
+ *          permutations are ranked by their lehmer-code in factorial-base: the digit
+ *          of slot i is the number of not yet used pieces smaller than the piece at i,
+ *          counted with a single popcount over a bitmask of used pieces.
+ *
+ *          the ud-slice-edges are FR, FL, BL, BR (edges 8..11).
+ */
+
+namespace groubiks::coord {
+
+    using coord_t = std::uint32_t;
+
+    inline constexpr coord_t num_vertex_twists = 2187;     /* 3^7 */
+    inline constexpr coord_t num_edge_flips = 2048;        /* 2^11 */
+    inline constexpr coord_t num_vertex_perms = 40320;     /* 8! */
+    inline constexpr coord_t num_edge_perms = 479001600;   /* 12! */
+    inline constexpr coord_t num_ud_slices = 495;          /* 12 choose 4 */
+    inline constexpr coord_t num_ud_edge_perms = 40320;    /* 8!, edges 0..7 within slots 0..7 */
+    inline constexpr coord_t num_slice_perms = 24;         /* 4!, edges 8..11 within slots 8..11 */
+
+    namespace detail {
+
+        constexpr std::array<coord_t, 13> factorials = [] {
+            std::array<coord_t, 13> res{ 1 };
+            for (coord_t i = 1; i < 13; ++i)
+            { res[i] = res[i - 1] * i; }
+            return res;
+        }();
+
+        constexpr std::array<std::array<coord_t, 5>, 13> binomials = [] {
+            std::array<std::array<coord_t, 5>, 13> res{};
+            for (int n = 0; n < 13; ++n) {
+                res[n][0] = 1;
+                for (int k = 1; k < 5 && k <= n; ++k)
+                { res[n][k] = res[n - 1][k - 1] + (k < n ? res[n - 1][k] : 0); }
+            }
+            return res;
+        }();
+
+        /* lehmer-rank of the pieces p[0..n), which must be a permutation of 0..n-1. */
+        template<int N, class Fn>
+        constexpr coord_t rank_perm(Fn&& piece_at) {
+            coord_t res = 0;
+            std::uint32_t used = 0;
+            for (int i = 0; i < N - 1; ++i) {
+                const int p = piece_at(i);
+                const int digit = p - std::popcount(used & ((1u << p) - 1));
+                res += digit * factorials[N - 1 - i];
+                used |= 1u << p;
+            }
+            return res;
+        }
+
+        /**
+         * @brief inverse of rank_perm(): calls set_piece(i, p) for every slot.
+         * @details the unused pieces are kept in order as a list of nibbles,
+         *          so the digit-th of them is a shift and removing it a mask.
+         */
+        template<int N, class Fn>
+        constexpr void unrank_perm(coord_t rank, Fn&& set_piece) {
+            static_assert(N <= 16);
+            std::uint64_t unused = 0;
+            for (int p = N - 1; p >= 0; --p)
+            { unused = unused << 4 | std::uint64_t(p); }
+            for (int i = 0; i < N; ++i) {
+                const coord_t f = factorials[N - 1 - i];
+                const int shift = 4 * int(rank / f);
+                rank %= f;
+                const std::uint64_t below = unused & ((std::uint64_t(1) << shift) - 1);
+                set_piece(i, int(unused >> shift & 0xf));
+                unused = below | (unused >> shift >> 4) << shift;
+            }
+        }
+
+        /* the parity of the permutation with lehmer-rank `rank`: the parity of its digit-sum. */
+        template<int N>
+        constexpr int rank_parity(coord_t rank) {
+            coord_t sum = 0;
+            for (int i = 0; i < N - 1; ++i) {
+                const coord_t f = factorials[N - 1 - i];
+                sum += rank / f;
+                rank %= f;
+            }
+            return int(sum & 1);
+        }
+
+    }
+
+    /**
+     * @name orientation-coordinates. the orientation of the last slot
+     *       is implied by the others (sum of twists = 0 mod 3, sum of flips = 0 mod 2).
+     * @{
+     */
+    constexpr coord_t vertex_twist(const cube& c) {
+        coord_t res = 0;
+        for (int i = 0; i < cube::num_vertices - 1; ++i)
+        { res = res * 3 + c.vertex_twist(i); }
+        return res;
+    }
+
+    constexpr void set_vertex_twist(cube& c, coord_t twist) {
+        int sum = 0;
+        for (int i = cube::num_vertices - 2; i >= 0; --i) {
+            const int t = twist % 3;
+            twist /= 3;
+            sum += t;
+            c.set_vertex(i, c.vertex(i), t);
+        }
+        c.set_vertex(cube::num_vertices - 1, c.vertex(cube::num_vertices - 1), (3 - sum % 3) % 3);
+    }
+
+    constexpr coord_t edge_flip(const cube& c) {
+        coord_t res = 0;
+        for (int i = 0; i < cube::num_edges - 1; ++i)
+        { res = res << 1 | c.edge_flip(i); }
+        return res;
+    }
+
+    constexpr void set_edge_flip(cube& c, coord_t flip) {
+        const int parity = std::popcount(flip) & 1;
+        for (int i = cube::num_edges - 2; i >= 0; --i) {
+            c.set_edge(i, c.edge(i), flip & 1);
+            flip >>= 1;
+        }
+        c.set_edge(cube::num_edges - 1, c.edge(cube::num_edges - 1), parity);
+    }
+    /**
+     * @}
+     */
+
+    /**
+     * @name permutation-coordinates.
+     * @{
+     */
+    constexpr coord_t vertex_perm(const cube& c)
+    { return detail::rank_perm<cube::num_vertices>([&c](int i) { return c.vertex(i); }); }
+
+    constexpr void set_vertex_perm(cube& c, coord_t perm) {
+        detail::unrank_perm<cube::num_vertices>(perm,
+            [&c](int i, int p) { c.set_vertex(i, p, c.vertex_twist(i)); });
+    }
+
+    constexpr coord_t edge_perm(const cube& c)
+    { return detail::rank_perm<cube::num_edges>([&c](int i) { return c.edge(i); }); }
+
+    constexpr void set_edge_perm(cube& c, coord_t perm) {
+        detail::unrank_perm<cube::num_edges>(perm,
+            [&c](int i, int p) { c.set_edge(i, p, c.edge_flip(i)); });
+    }
+    /**
+     * @}
+     */
+
+    /**
+     * @name ud-slice-coordinates.
+     * @{
+     */
+
+    /**
+     * @brief the set of slots occupied by the ud-slice-edges, ignoring their order.
+     *        ranked in the combinatorial number system over the mirrored slots 11-s,
+     *        so slots 8..11 (solved) are 0.
+     */
+    constexpr coord_t ud_slice(const cube& c) {
+        coord_t res = 0;
+        int k = 0;
+        for (int s = cube::num_edges - 1; s >= 0; --s) {
+            if (c.edge(s) >= 8)
+            { res += detail::binomials[cube::num_edges - 1 - s][++k]; }
+        }
+        return res;
+    }
+
+    /**
+     * @brief places the ud-slice-edges (in order) into the slots described by `slice`
+     *        and all other edges (in order) into the remaining slots. flips are kept.
+     */
+    constexpr void set_ud_slice(cube& c, coord_t slice) {
+        bool occupied[cube::num_edges] = {};
+        for (int k = 4, j = cube::num_edges - 1; k > 0; --j) {
+            if (detail::binomials[j][k] <= slice) {
+                slice -= detail::binomials[j][k];
+                occupied[cube::num_edges - 1 - j] = true;
+                --k;
+            }
+        }
+        int slice_edge = 8;
+        int other_edge = 0;
+        for (int s = 0; s < cube::num_edges; ++s)
+        { c.set_edge(s, occupied[s] ? slice_edge++ : other_edge++, c.edge_flip(s)); }
+    }
+
+    /* phase-2 coordinates. only meaningful if the slice-edges are within slots 8..11. */
+    constexpr coord_t ud_edge_perm(const cube& c)
+    { return detail::rank_perm<8>([&c](int i) { return c.edge(i); }); }
+
+    constexpr void set_ud_edge_perm(cube& c, coord_t perm) {
+        detail::unrank_perm<8>(perm,
+            [&c](int i, int p) { c.set_edge(i, p, c.edge_flip(i)); });
+    }
+
+    constexpr coord_t slice_perm(const cube& c)
+    { return detail::rank_perm<4>([&c](int i) { return c.edge(8 + i) - 8; }); }
+
+    constexpr void set_slice_perm(cube& c, coord_t perm) {
+        detail::unrank_perm<4>(perm,
+            [&c](int i, int p) { c.set_edge(8 + i, 8 + p, c.edge_flip(8 + i)); });
+    }
+    /**
+     * @}
+     */
+
+    /**
+     * @name single-edge-coordinate: slot * 2 + flip of one edge.
+     *       the 12 of them describe all edges, and each one moves through the same
+     *       small table, independent of the others.
+     * @{
+     */
+    inline constexpr coord_t num_edge_positions = 24;
+
+    constexpr coord_t edge_position(const cube& c, int edge) {
+        int s = 0;
+        while (c.edge(s) != edge)
+        { ++s; }
+        return coord_t(s * 2 + c.edge_flip(s));
+    }
+
+    /* swaps `edge` with the edge in the slot of `pos` and gives it the flip of `pos`. */
+    constexpr void set_edge_position(cube& c, int edge, coord_t pos) {
+        const int from = int(edge_position(c, edge) / 2), to = int(pos / 2);
+        c.set_edge(from, c.edge(to), c.edge_flip(to));
+        c.set_edge(to, edge, pos & 1);
+    }
+    /**
+     * @}
+     */
+
+    /**
+     * @brief a coordinate-type: its range, rank-function and set-function (unranking),
+     *        so generic code like solver::generate_move_table() can take any of them.
+     */
+    struct coordinate {
+        const char* name;
+        coord_t count;
+        coord_t (*rank)(const cube&);
+        void (*set)(cube&, coord_t);
+    };
+
+    /**
+     * @name the coordinate-types. the phase-2 coordinates (ud_edge_perm, slice_perm) are
+     *       only closed under the moves that keep the ud-slice-edges within the ud-slice.
+     * @{
+     */
+    inline constexpr coordinate vertex_twist_coord{ "vertex_twist", num_vertex_twists, vertex_twist, set_vertex_twist };
+    inline constexpr coordinate edge_flip_coord{ "edge_flip", num_edge_flips, edge_flip, set_edge_flip };
+    inline constexpr coordinate vertex_perm_coord{ "vertex_perm", num_vertex_perms, vertex_perm, set_vertex_perm };
+    inline constexpr coordinate ud_slice_coord{ "ud_slice", num_ud_slices, ud_slice, set_ud_slice };
+    inline constexpr coordinate ud_edge_perm_coord{ "ud_edge_perm", num_ud_edge_perms, ud_edge_perm, set_ud_edge_perm };
+    inline constexpr coordinate slice_perm_coord{ "slice_perm", num_slice_perms, slice_perm, set_slice_perm };
+    /* edge 0 stands for every edge, they all move the same way. */
+    inline constexpr coordinate edge_position_coord{ "edge_position", num_edge_positions,
+        [](const cube& c) { return edge_position(c, 0); },
+        [](cube& c, coord_t pos) { set_edge_position(c, 0, pos); } };
+    /**
+     * @}
+     */
+
+    /**
+     * @returns the parity (0 even, 1 odd) of the permutations.
+     *          a reachable cube always has equal vertex- and edge-parity.
+     */
+    constexpr int vertex_parity(const cube& c) {
+        int res = 0;
+        for (int i = 0; i < cube::num_vertices; ++i)
+            for (int j = i + 1; j < cube::num_vertices; ++j)
+            { res ^= c.vertex(i) > c.vertex(j); }
+        return res;
+    }
+
+    constexpr int edge_parity(const cube& c) {
+        int res = 0;
+        for (int i = 0; i < cube::num_edges; ++i)
+            for (int j = i + 1; j < cube::num_edges; ++j)
+            { res ^= c.edge(i) > c.edge(j); }
+        return res;
+    }
+
+#ifdef BUILD_TESTS
+    int coord_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,186 @@
+#ifndef GROUBIKS_CUBE_FACELETS_HPP
+#define GROUBIKS_CUBE_FACELETS_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file facelets.hpp
+ * @brief conversion between cubes and the colors of their 54 stickers (facelets).
+ * @details the facelets are numbered face by face in the order U R F D L B, every face
+ *          row by row as seen from outside, with U above F and D below F, R and L next
+ *          to F and B next to R (the net of kociemba's facelet-strings):
+ *
+ *                       U0 U1 U2
+ *                       U3 U4 U5
+ *                       U6 U7 U8
+ *              L36 ..   F18 ..    R9 ..   B45 ..
+ *                       D27 ..
+ *
+ *          the center of a face (facelet 9 * f + 4) never moves, so it tells which color
+ *          belongs to which face. a piece is then found by a single table-lookup of the
+ *          faces of its stickers, which also yields its orientation.
+ */
+
+namespace groubiks {
+
+    inline constexpr int num_facelets = 54;
+
+    using facelet_colors = std::array<color_t, num_facelets>;
+    /* the color of every face, indexed by face_t. */
+    using color_scheme = std::array<color_t, num_faces>;
+
+    /* white on top, green in front, red on the right. */
+    inline constexpr color_scheme default_scheme = { WHITE, RED, GREEN, YELLOW, ORANGE, BLUE };
+
+    namespace detail {
+
+        /* the facelets of every slot, the U/D-facelet first, then clockwise. */
+        constexpr std::uint8_t vertex_facelets[cube::num_vertices][3] = {
+            { 8, 9, 20 }, { 6, 18, 38 }, { 0, 36, 47 }, { 2, 45, 11 },
+            { 29, 26, 15 }, { 27, 44, 24 }, { 33, 53, 42 }, { 35, 17, 51 }
+        };
+        constexpr std::uint8_t edge_facelets[cube::num_edges][2] = {
+            { 5, 10 }, { 7, 19 }, { 3, 37 }, { 1, 46 }, { 32, 16 }, { 28, 25 },
+            { 30, 43 }, { 34, 52 }, { 23, 12 }, { 21, 41 }, { 50, 39 }, { 48, 14 }
+        };
+        /* the faces of every piece, in the same order as the facelets of its own slot. */
+        constexpr std::uint8_t vertex_faces[cube::num_vertices][3] = {
+            { 0, 1, 2 }, { 0, 2, 4 }, { 0, 4, 5 }, { 0, 5, 1 },
+            { 3, 2, 1 }, { 3, 4, 2 }, { 3, 5, 4 }, { 3, 1, 5 }
+        };
+        constexpr std::uint8_t edge_faces[cube::num_edges][2] = {
+            { 0, 1 }, { 0, 2 }, { 0, 4 }, { 0, 5 }, { 3, 1 }, { 3, 2 },
+            { 3, 4 }, { 3, 5 }, { 2, 1 }, { 2, 4 }, { 5, 4 }, { 5, 1 }
+        };
+
+        /**
+         * @brief the piece-byte (piece | orientation << 4, as in cube::vertex_bits) of the faces
+         *        a, b, c seen on the facelets of a slot, at [36 * a + 6 * b + c]. 0xff if no
+         *        piece has these faces in this order.
+         *        a piece with orientation o shows its n-th face on the slot's facelet (n + o) % 3.
+         */
+        constexpr std::array<std::uint8_t, 216> make_vertex_lookup() {
+            std::array<std::uint8_t, 216> res{};
+            res.fill(0xff);
+            for (int p = 0; p < cube::num_vertices; ++p) {
+                for (int o = 0; o < 3; ++o) {
+                    std::uint8_t seen[3];
+                    for (int n = 0; n < 3; ++n)
+                    { seen[(n + o) % 3] = vertex_faces[p][n]; }
+                    res[36 * seen[0] + 6 * seen[1] + seen[2]] = std::uint8_t(p | o << cube::orientation_shift);
+                }
+            }
+            return res;
+        }
+
+        constexpr std::array<std::uint8_t, 36> make_edge_lookup() {
+            std::array<std::uint8_t, 36> res{};
+            res.fill(0xff);
+            for (int p = 0; p < cube::num_edges; ++p) {
+                for (int o = 0; o < 2; ++o)
+                { res[6 * edge_faces[p][o] + edge_faces[p][1 - o]] = std::uint8_t(p | o << cube::orientation_shift); }
+            }
+            return res;
+        }
+
+        inline constexpr std::array<std::uint8_t, 216> vertex_lookup = make_vertex_lookup();
+        inline constexpr std::array<std::uint8_t, 36> edge_lookup = make_edge_lookup();
+
+    }
+
+    /* writes the sticker-colors of `c` to `out`, painting face f with scheme[f]. */
+    constexpr void to_facelets(const cube& c, std::span<color_t, num_facelets> out,
+        const color_scheme& scheme = default_scheme)
+    {
+        for (int f = 0; f < num_faces; ++f)
+        { out[9 * f + 4] = scheme[f]; }
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            const int p = c.vertex(i), o = c.vertex_twist(i);
+            for (int n = 0; n < 3; ++n)
+            { out[detail::vertex_facelets[i][(n + o) % 3]] = scheme[detail::vertex_faces[p][n]]; }
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            const int p = c.edge(i), o = c.edge_flip(i);
+            for (int n = 0; n < 2; ++n)
+            { out[detail::edge_facelets[i][(n + o) % 2]] = scheme[detail::edge_faces[p][n]]; }
+        }
+    }
+
+    constexpr facelet_colors to_facelets(const cube& c, const color_scheme& scheme = default_scheme) {
+        facelet_colors res{};
+        to_facelets(c, res, scheme);
+        return res;
+    }
+
+    /**
+     * @brief reads a cube from the colors of its stickers, in any color-scheme.
+     * @returns nothing if the centers do not show six different colors or a slot shows
+     *          a combination of colors no piece has. other defects (a piece twice,
+     *          wrong twist or parity) are left to validate().
+     */
+    constexpr std::optional<cube> from_facelets(std::span<const color_t, num_facelets> colors) {
+        /* face of every color, 0xff for colors of no center. */
+        std::uint8_t face_of[num_faces] = { 0xff, 0xff, 0xff, 0xff, 0xff, 0xff };
+        for (int f = 0; f < num_faces; ++f) {
+            const unsigned color = unsigned(colors[9 * f + 4]);
+            if (color >= num_faces || face_of[color] != 0xff)
+            { return std::nullopt; }
+            face_of[color] = std::uint8_t(f);
+        }
+        auto face = [&](int facelet) {
+            const unsigned color = unsigned(colors[facelet]);
+            return color < num_faces ? face_of[color] : std::uint8_t(0xff);
+        };
+
+        cube res{ 0, 0 };
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            const std::uint8_t a = face(detail::vertex_facelets[i][0]);
+            const std::uint8_t b = face(detail::vertex_facelets[i][1]);
+            const std::uint8_t c = face(detail::vertex_facelets[i][2]);
+            if (a >= num_faces || b >= num_faces || c >= num_faces)
+            { return std::nullopt; }
+            const std::uint8_t piece = detail::vertex_lookup[36 * a + 6 * b + c];
+            if (piece == 0xff)
+            { return std::nullopt; }
+            res.vertex_bits |= cube::word_type(piece) << (i * cube::vertex_field_bits);
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            const std::uint8_t a = face(detail::edge_facelets[i][0]);
+            const std::uint8_t b = face(detail::edge_facelets[i][1]);
+            if (a >= num_faces || b >= num_faces)
+            { return std::nullopt; }
+            const std::uint8_t piece = detail::edge_lookup[6 * a + b];
+            if (piece == 0xff)
+            { return std::nullopt; }
+            res.edge_bits |= cube::word_type(piece) << (i * cube::edge_field_bits);
+        }
+        return res;
+    }
+
+    /**
+     * @brief to_facelets() of every cube, 54 colors per cube.
+     *        `out` must hold at least 54 * cubes.size() colors.
+     */
+    void to_facelets(std::span<const cube> cubes, std::span<color_t> out, const color_scheme& scheme = default_scheme);
+
+    /**
+     * @brief from_facelets() of every group of 54 colors, into `out`.
+     * @returns the number of cubes read before the first unreadable one,
+     *          i.e. out.size() if all of them could be read.
+     */
+    std::size_t from_facelets(std::span<const color_t> colors, std::span<cube> out);
+
+#ifdef BUILD_TESTS
+    int facelets_test(std::ostream& os);
+#endif
+
+}
+
+#endif
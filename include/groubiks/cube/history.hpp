@@ -0,0 +1,105 @@
+#ifndef GROUBIKS_CUBE_HISTORY_HPP
+#define GROUBIKS_CUBE_HISTORY_HPP
+
+#include <array>
+#include <cstddef>
+#include <memory>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <vector>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file history.hpp
+ * @brief the moves of a session or replay, with undo, redo and jumps to any point.
+ * @details moves are logged with one byte each, in chunks of chunk_moves moves that are
+ *          allocated once and never move. every chunk starts with a checkpoint, the cube
+ *          before its first move, so a long log never copies itself while growing and keeps
+ *          only one cube per chunk.
+ *
+ *          the current state is kept at the cursor: undo and redo apply one move (or its
+ *          inverse). state_at() and seek() start at the closest known state (the cursor,
+ *          the checkpoint before or the checkpoint after the target, walked backwards
+ *          with inverse moves). that is at most chunk_moves / 2 moves away, and at most
+ *          chunk_moves in the last chunk, which has no checkpoint after it, however long
+ *          the log is.
+ */
+
+namespace groubiks {
+
+    class move_history {
+    public:
+        /* moves per chunk, i.e. the distance of the checkpoints. */
+        static constexpr std::size_t chunk_moves = 1024;
+
+        explicit move_history(const cube& start = cube::get_solved());
+        move_history(move_history&& other) noexcept = default;
+        move_history& operator=(move_history&& other) noexcept = default;
+        ~move_history() = default;
+
+        /* the moves in the log, including those undone. */
+        std::size_t size() const { return m_size; }
+        /* the number of moves applied to state(), 0..size(). */
+        std::size_t position() const { return m_position; }
+        const cube& state() const { return m_state; }
+        const cube& start() const { return m_chunks.front()->start; }
+
+        move_t operator[](std::size_t idx) const
+        { return m_chunks[idx / chunk_moves]->moves[idx % chunk_moves]; }
+
+        /**
+         * @brief applies `m` at the cursor. the undone moves after the cursor are dropped.
+         */
+        void push(move_t m);
+        void push(std::span<const move_t> seq);
+
+        /**
+         * @returns false if there is nothing to undo (redo).
+         */
+        bool undo();
+        bool redo();
+
+        /**
+         * @brief moves the cursor to `pos`, the moves after it stay redoable.
+         * @returns false (and keeps the cursor) if `pos` is past size().
+         */
+        bool seek(std::size_t pos);
+
+        /* the cube after the first `pos` moves, pos <= size(). the cursor is kept. */
+        cube state_at(std::size_t pos) const;
+        /* the number of moves state_at(pos) and seek(pos) apply. */
+        std::size_t jump_cost(std::size_t pos) const;
+
+        /* empties the log, which then starts with `start`. */
+        void clear(const cube& start = cube::get_solved());
+
+        /* the memory held by the log. */
+        std::size_t bytes() const;
+
+    private:
+        struct chunk {
+            /* the checkpoint: the cube before moves[0]. */
+            cube start;
+            std::array<move_t, chunk_moves> moves;
+        };
+
+        /* the closest position to `pos` with a known cube, and that cube. */
+        std::pair<std::size_t, cube> origin(std::size_t pos) const;
+        /* the cube at position `to`, walked from the cube `c` at position `from`. */
+        cube walk(cube c, std::size_t from, std::size_t to) const;
+
+        std::vector<std::unique_ptr<chunk>> m_chunks;
+        std::size_t m_size = 0;
+        std::size_t m_position = 0;
+        cube m_state;
+    };
+
+#ifdef BUILD_TESTS
+    int history_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,231 @@
+
+#ifndef GROUBIKS_CUBE_MOVES_HPP
+#define GROUBIKS_CUBE_MOVES_HPP
+
+#include <array>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <groubiks/cube.hpp>
+
+namespace groubiks {
+
+    /*
+     * the six faces in the order U, R, F, D, L, B.
+     * opposite faces are always 3 apart.
+     */
+    enum class face_t : std::uint8_t {
+        U, R, F, D, L, B
+    };
+
+    /*
+     * the 18 face-turns of the half-turn-metric.
+     * every face has 3 consecutive entries: a clockwise quarter-turn,
+     * a half-turn and a counter-clockwise quarter-turn (prime).
+     */
+    enum class move_t : std::uint8_t {
+        U, U2, Up,
+        R, R2, Rp,
+        F, F2, Fp,
+        D, D2, Dp,
+        L, L2, Lp,
+        B, B2, Bp
+    };
+
+    inline constexpr int num_faces = 6;
+    inline constexpr int num_moves = 18;
+
+    constexpr face_t move_face(move_t m)
+    { return face_t(std::uint8_t(m) / 3); }
+    /* the number of clockwise quarter-turns (1..3) */
+    constexpr int move_power(move_t m)
+    { return std::uint8_t(m) % 3 + 1; }
+    constexpr move_t make_move(face_t f, int power)
+    { return move_t(std::uint8_t(f) * 3 + (power - 1)); }
+    constexpr move_t inverse_move(move_t m)
+    { return make_move(move_face(m), 4 - move_power(m)); }
+    constexpr face_t opposite_face(face_t f)
+    { return face_t((std::uint8_t(f) + 3) % num_faces); }
+
+    inline constexpr std::array<std::string_view, num_moves> move_names = {
+        "U", "U2", "U'", "R", "R2", "R'", "F", "F2", "F'",
+        "D", "D2", "D'", "L", "L2", "L'", "B", "B2", "B'"
+    };
+
+    /*
+     * a move in its "replaced-by" form: after the move, slot i holds the piece
+     * that was at slot perm[i] before, with its orientation increased by the
+     * corresponding twist/flip (mod 3 for vertices, mod 2 for edges).
+     * the orientation-changes are stored pre-shifted in the packed layout of
+     * cube::vertex_bits/edge_bits, so they can be applied to all slots at once.
+     */
+    struct move_entry {
+        std::uint8_t vertex_perm[cube::num_vertices];
+        std::uint8_t edge_perm[cube::num_edges];
+        cube::word_type vertex_twists;
+        cube::word_type edge_flips;
+    };
+
+    /**
+     * @brief composes two cubes: the resulting cube is `a` with the
+     *        permutation and orientation-changes of `b` applied afterwards.
+     */
+    constexpr cube multiply(const cube& a, const cube& b) {
+        cube res{ 0, 0 };
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            const int from = b.vertex(i);
+            int twist = a.vertex_twist(from) + b.vertex_twist(i);
+            twist -= (twist >= 3) * 3;
+            res.set_vertex(i, a.vertex(from), twist);
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            const int from = b.edge(i);
+            res.set_edge(i, a.edge(from), a.edge_flip(from) ^ b.edge_flip(i));
+        }
+        return res;
+    }
+
+    /**
+     * @returns the cube that undoes `c`, i.e. multiply(c, inverse(c)) is solved.
+     */
+    constexpr cube inverse(const cube& c) {
+        cube res{ 0, 0 };
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            const int twist = c.vertex_twist(i);
+            res.set_vertex(c.vertex(i), i, twist == 0 ? 0 : 3 - twist);
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            res.set_edge(c.edge(i), i, c.edge_flip(i));
+        }
+        return res;
+    }
+
+    namespace detail {
+
+        constexpr cube make_cube(const int (&vp)[8], const int (&vt)[8], const int (&ep)[12], const int (&ef)[12]) {
+            cube::layout l{};
+            for (int i = 0; i < cube::num_vertices; ++i)
+            { l.vertices[i] = vp[i]; l.vertex_twists[i] = vt[i]; }
+            for (int i = 0; i < cube::num_edges; ++i)
+            { l.edges[i] = ep[i]; l.edge_flips[i] = ef[i]; }
+            return cube::pack(l);
+        }
+
+        /* the clockwise quarter-turns of all faces, in the order U, R, F, D, L, B. */
+        constexpr std::array<cube, num_faces> quarter_turns = {
+            make_cube({ 3, 0, 1, 2, 4, 5, 6, 7 }, { 0, 0, 0, 0, 0, 0, 0, 0 },
+                      { 3, 0, 1, 2, 4, 5, 6, 7, 8, 9, 10, 11 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }),
+            make_cube({ 4, 1, 2, 0, 7, 5, 6, 3 }, { 2, 0, 0, 1, 1, 0, 0, 2 },
+                      { 8, 1, 2, 3, 11, 5, 6, 7, 4, 9, 10, 0 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }),
+            make_cube({ 1, 5, 2, 3, 0, 4, 6, 7 }, { 1, 2, 0, 0, 2, 1, 0, 0 },
+                      { 0, 9, 2, 3, 4, 8, 6, 7, 1, 5, 10, 11 }, { 0, 1, 0, 0, 0, 1, 0, 0, 1, 1, 0, 0 }),
+            make_cube({ 0, 1, 2, 3, 5, 6, 7, 4 }, { 0, 0, 0, 0, 0, 0, 0, 0 },
+                      { 0, 1, 2, 3, 5, 6, 7, 4, 8, 9, 10, 11 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }),
+            make_cube({ 0, 2, 6, 3, 4, 1, 5, 7 }, { 0, 1, 2, 0, 0, 2, 1, 0 },
+                      { 0, 1, 10, 3, 4, 5, 9, 7, 8, 2, 6, 11 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 }),
+            make_cube({ 0, 1, 3, 7, 4, 5, 2, 6 }, { 0, 0, 1, 2, 0, 0, 2, 1 },
+                      { 0, 1, 2, 11, 4, 5, 6, 10, 8, 9, 3, 7 }, { 0, 0, 0, 1, 0, 0, 0, 1, 0, 0, 1, 1 })
+        };
+
+        constexpr std::array<cube, num_moves> make_move_cubes() {
+            std::array<cube, num_moves> res{};
+            for (int f = 0; f < num_faces; ++f) {
+                cube c = cube::get_solved();
+                for (int p = 0; p < 3; ++p) {
+                    c = multiply(c, quarter_turns[f]);
+                    res[f * 3 + p] = c;
+                }
+            }
+            return res;
+        }
+
+        constexpr std::array<move_entry, num_moves> make_move_table(const std::array<cube, num_moves>& cubes) {
+            constexpr cube::word_type orientation_bits = 0x3030303030303030ull;
+            std::array<move_entry, num_moves> res{};
+            for (int m = 0; m < num_moves; ++m) {
+                for (int i = 0; i < cube::num_vertices; ++i)
+                { res[m].vertex_perm[i] = cubes[m].vertex(i); }
+                for (int i = 0; i < cube::num_edges; ++i) {
+                    res[m].edge_perm[i] = cubes[m].edge(i);
+                    res[m].edge_flips |= cube::word_type(cubes[m].edge_flip(i))
+                        << (i * cube::edge_field_bits + cube::orientation_shift);
+                }
+                res[m].vertex_twists = cubes[m].vertex_bits & orientation_bits;
+            }
+            return res;
+        }
+
+    }
+
+    /* all 18 moves as cubes, i.e. the result of applying the move to a solved cube. */
+    inline constexpr std::array<cube, num_moves> move_cubes = detail::make_move_cubes();
+    /* all 18 moves as lookup-tables, generated at compile-time. */
+    inline constexpr std::array<move_entry, num_moves> move_table = detail::make_move_table(move_cubes);
+
+    /**
+     * @brief applies a single face-turn to a cube.
+     *        (scalar reference-implementation, usable in constant expressions)
+     * @details the pieces are gathered field by field, the orientations are then
+     *          updated for all slots at once (swar): adding the twists leaves a
+     *          value of 0..4 in every twist-field, fields of 3 or more are found by
+     *          adding 1 and testing bit 2 and get 3 subtracted.
+     */
+    constexpr void apply_move(cube& c, move_t m) {
+        const move_entry& e = move_table[std::uint8_t(m)];
+        cube::word_type vertices = 0;
+        cube::word_type edges = 0;
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            vertices |= ((c.vertex_bits >> (e.vertex_perm[i] * cube::vertex_field_bits)) & cube::vertex_field_mask)
+                << (i * cube::vertex_field_bits);
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            edges |= ((c.edge_bits >> (e.edge_perm[i] * cube::edge_field_bits)) & cube::edge_field_mask)
+                << (i * cube::edge_field_bits);
+        }
+        vertices += e.vertex_twists;
+        const cube::word_type overflow = (vertices + 0x1010101010101010ull) & 0x4040404040404040ull;
+        c.vertex_bits = vertices - ((overflow >> 1) | (overflow >> 2));
+        c.edge_bits = edges ^ e.edge_flips;
+    }
+
+    constexpr void apply_sequence(cube& c, std::span<const move_t> seq) {
+        for (move_t m : seq)
+        { apply_move(c, m); }
+    }
+
+    /*
+     * the finite automaton of canonical move-sequences (see canonicalize() in notation.hpp),
+     * for searches to expand only the moves that can start a shorter or a new sequence.
+     * a state is the face of the last move, or sequence_start before the first one.
+     * no move follows a turn of its own face (R R, R R'), nor a turn of the opposite face
+     * that comes later in the order U R F D L B (U D is expanded, D U is not, and R L R never).
+     * this leaves 18, then 15 or 12 successors, about 13.35 per node in a deep tree.
+     */
+    inline constexpr int sequence_start = num_faces;
+    inline constexpr int num_sequence_states = num_faces + 1;
+
+    /* bit m is set if move m may follow in the state. */
+    inline constexpr std::array<std::uint32_t, num_sequence_states> successor_moves = [] {
+        std::array<std::uint32_t, num_sequence_states> res{};
+        for (int state = 0; state < num_sequence_states; ++state) {
+            for (int m = 0; m < num_moves; ++m) {
+                const int f = m / 3;
+                const bool same = f == state;
+                const bool commuted = state < num_faces && state >= 3 && f == state - 3;
+                if (!same && !commuted)
+                { res[state] |= std::uint32_t(1) << m; }
+            }
+        }
+        return res;
+    }();
+
+    constexpr int next_sequence_state(move_t m)
+    { return int(move_face(m)); }
+
+#ifdef BUILD_TESTS
+    int moves_test(std::ostream& os);
+#endif
+
+}
+
+#endif
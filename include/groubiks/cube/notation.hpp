@@ -0,0 +1,75 @@
+#ifndef GROUBIKS_CUBE_NOTATION_HPP
+#define GROUBIKS_CUBE_NOTATION_HPP
+
+#include <cstddef>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file notation.hpp
+ * @brief reading and writing move-sequences, and reducing them to a canonical form.
+ * @details a cube keeps its centers in place (see cube.hpp), so everything is read into
+ *          the 18 face-turns of move_t:
+ *          - rotations (x, y, z) emit no move, they only relabel the faces of the moves after them,
+ *          - wide moves turn the opposite face and rotate: Rw = r = L x,
+ *          - slice moves turn both outer faces and rotate: M = R L' x', E = U D' y', S = F' B z.
+ *          the resulting sequence leaves the pieces in the same place relative to the centers
+ *          as the original one.
+ */
+
+namespace groubiks {
+
+    enum class notation {
+        /**
+         * U R F D L B with suffixes ' (inverse) and a count (2 for a half-turn, 3 = '),
+         * wide moves as Uw or u, slices M E S, rotations x y z. whitespace is ignored.
+         */
+        standard,
+        /**
+         * the form of cube.py: one letter per quarter-turn, uppercase clockwise,
+         * lowercase counter-clockwise, e.g. "FRuruRUrf". whitespace is ignored.
+         */
+        lowercase_inverse
+    };
+
+    /**
+     * @brief appends the face-turns of `text` to `out`.
+     * @returns false on the first character that does not belong to the notation;
+     *          its offset is stored in `error_offset` (if given) and `out` keeps
+     *          the moves read before it.
+     */
+    bool parse_moves(std::string_view text, std::vector<move_t>& out, notation n = notation::standard,
+        std::size_t* error_offset = nullptr);
+
+    /* @returns the face-turns of `text`, or nothing if it is malformed. */
+    std::optional<std::vector<move_t>> parse_moves(std::string_view text, notation n = notation::standard);
+
+    /* writes `moves` in notation `n`: "R U2 F'" (standard) or "RUUf" (lowercase_inverse). */
+    std::string format_moves(std::span<const move_t> moves, notation n = notation::standard);
+
+    /**
+     * @brief reduces `moves` in place to its canonical form, which does the same to the cube:
+     *        - consecutive turns of a face are merged (R R -> R2) or cancelled (R R' -> nothing),
+     *        - so are turns of a face separated only by turns of the opposite face (R L R -> R2 L),
+     *        - two consecutive turns of opposite faces, which commute, are ordered U R F before D L B.
+     *        no canonical sequence can be shortened by these rules, and only canonical
+     *        sequences have to be enumerated by a search.
+     * @returns the new length.
+     */
+    std::size_t canonicalize(std::vector<move_t>& moves);
+
+    /* @returns whether canonicalize() would leave `moves` unchanged. */
+    bool is_canonical(std::span<const move_t> moves);
+
+#ifdef BUILD_TESTS
+    int notation_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,214 @@
+#ifndef GROUBIKS_CUBE_NXN_HPP
+#define GROUBIKS_CUBE_NXN_HPP
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <utility>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file nxn.hpp
+ * @brief cubes of any size N (2x2, 4x4, 5x5, ...), with everything sized at compile-time.
+ * @details the pieces of a big cube are not all distinguishable (the centers of a face
+ *          look the same), so basic_cube<N> stores what can be seen: the face-color of each of
+ *          its 6 * N * N stickers. stickers are numbered face by face in the order U R F D L B,
+ *          row by row, exactly as the facelets of the 3x3 (see facelets.hpp), so
+ *          basic_cube<3> shows the same stickers as to_facelets() of a cube.
+ *
+ *          a move turns layer l (0 = the outer one) of a face clockwise by 1..3 quarters.
+ *          layers l < N / 2 can be turned from each face, the middle layer of an odd cube
+ *          is a turn of both outer faces instead. moves are numbered 18 * l + 3 * face + power - 1,
+ *          so the outer moves have the numbers of move_t.
+ *
+ *          every layer-turn permutes its stickers in 4-cycles. the cycles are computed at
+ *          compile-time from the geometry of the cube, and every move gets its own kernel
+ *          with the cycles fully unrolled (no loops, no index-tables at runtime).
+ */
+
+namespace groubiks {
+
+    template<int N>
+    class basic_cube {
+    public:
+        static_assert(N >= 2, "a cube has at least two layers");
+
+        using sticker_type = std::uint8_t;
+
+        static constexpr int size = N;
+        static constexpr int num_corners = 8;
+        static constexpr int num_edges = 12 * (N - 2);
+        static constexpr int num_centers = 6 * (N - 2) * (N - 2);
+        static constexpr int num_stickers = 6 * N * N;
+        /* layers that can be turned from each face. */
+        static constexpr int num_layers = N / 2;
+        static constexpr int num_moves = num_faces * 3 * num_layers;
+
+        /* the face whose color every sticker shows. */
+        std::array<sticker_type, num_stickers> stickers;
+
+        static constexpr basic_cube get_solved() {
+            basic_cube res{};
+            for (int i = 0; i < num_stickers; ++i)
+            { res.stickers[i] = sticker_type(i / (N * N)); }
+            return res;
+        }
+
+        /* every face shows a single color (for even N in any orientation of the cube). */
+        constexpr bool is_solved() const {
+            for (int i = 0; i < num_stickers; ++i) {
+                if (stickers[i] != stickers[i / (N * N) * N * N])
+                { return false; }
+            }
+            return true;
+        }
+
+        friend constexpr bool operator==(const basic_cube&, const basic_cube&) = default;
+    };
+
+    using cube2 = basic_cube<2>;
+    using cube3 = basic_cube<3>;
+    using cube4 = basic_cube<4>;
+    using cube5 = basic_cube<5>;
+
+    /* the move turning `layer` of face `f` clockwise by `power` quarter-turns. */
+    constexpr int layer_move(face_t f, int layer, int power)
+    { return 18 * layer + 3 * int(f) + power - 1; }
+
+    namespace detail {
+
+        struct vec3 {
+            int x, y, z;
+            friend constexpr bool operator==(const vec3&, const vec3&) = default;
+        };
+
+        constexpr vec3 operator+(vec3 a, vec3 b) { return { a.x + b.x, a.y + b.y, a.z + b.z }; }
+        constexpr vec3 operator*(int s, vec3 a) { return { s * a.x, s * a.y, s * a.z }; }
+        constexpr int dot(vec3 a, vec3 b) { return a.x * b.x + a.y * b.y + a.z * b.z; }
+        constexpr vec3 cross(vec3 a, vec3 b)
+        { return { a.y * b.z - a.z * b.y, a.z * b.x - a.x * b.z, a.x * b.y - a.y * b.x }; }
+
+        /**
+         * @brief the outward normal of every face, and the directions of the rows and columns
+         *        of its stickers (x: L to R, y: D to U, z: B to F), as in the facelet-net.
+         */
+        constexpr vec3 face_normal[num_faces] = { { 0, 1, 0 }, { 1, 0, 0 }, { 0, 0, 1 }, { 0, -1, 0 }, { -1, 0, 0 }, { 0, 0, -1 } };
+        constexpr vec3 face_row[num_faces] = { { 0, 0, 1 }, { 0, -1, 0 }, { 0, -1, 0 }, { 0, 0, -1 }, { 0, -1, 0 }, { 0, -1, 0 } };
+        constexpr vec3 face_col[num_faces] = { { 1, 0, 0 }, { 0, 0, -1 }, { 1, 0, 0 }, { 1, 0, 0 }, { 0, 0, 1 }, { -1, 0, 0 } };
+
+        /**
+         * @brief the center of the piece carrying sticker i, in doubled coordinates
+         *        (-(N - 1) .. N - 1 in steps of 2), and the normal of the sticker.
+         */
+        template<int N>
+        constexpr std::pair<vec3, vec3> sticker_geometry(int i) {
+            const int f = i / (N * N), row = i / N % N, col = i % N;
+            const vec3 center = (N - 1) * face_normal[f] + (2 * row - (N - 1)) * face_row[f] + (2 * col - (N - 1)) * face_col[f];
+            return { center, face_normal[f] };
+        }
+
+        template<int N>
+        constexpr int sticker_at(vec3 center, vec3 normal) {
+            for (int i = 0; i < 6 * N * N; ++i) {
+                if (sticker_geometry<N>(i) == std::pair{ center, normal })
+                { return i; }
+            }
+            return -1;
+        }
+
+        /* the clockwise quarter-turn (seen from outside) around `axis`: -90 degrees. */
+        constexpr vec3 turn(vec3 axis, vec3 p)
+        { return dot(axis, p) * axis + -1 * cross(axis, p); }
+
+        /* the 4-cycles of one layer-turn: outer layers turn their face too (but not its center). */
+        constexpr int num_layer_cycles(int n, int layer)
+        { return layer == 0 ? n + (n * n - n % 2) / 4 : n; }
+
+        using sticker_cycle = std::array<std::uint16_t, 4>;
+
+        /* [face]: the cycles (a, turn(a), turn^2(a), turn^3(a)) of the stickers moved by `Layer` of face. */
+        template<int N, int Layer>
+        constexpr std::array<std::array<sticker_cycle, num_layer_cycles(N, Layer)>, num_faces> make_layer_cycles() {
+            std::array<std::array<sticker_cycle, num_layer_cycles(N, Layer)>, num_faces> res{};
+            for (int f = 0; f < num_faces; ++f) {
+                const vec3 axis = face_normal[f];
+                bool done[6 * N * N] = {};
+                int count = 0;
+                for (int i = 0; i < 6 * N * N; ++i) {
+                    const auto [center, normal] = sticker_geometry<N>(i);
+                    if (done[i] || dot(axis, center) != N - 1 - 2 * Layer)
+                    { continue; }
+                    vec3 c = center, n = normal;
+                    if (turn(axis, c) == c)
+                    { continue; }
+                    for (int k = 0; k < 4; ++k) {
+                        const int s = sticker_at<N>(c, n);
+                        res[f][count][k] = std::uint16_t(s);
+                        done[s] = true;
+                        c = turn(axis, c);
+                        n = turn(axis, n);
+                    }
+                    ++count;
+                }
+            }
+            return res;
+        }
+
+        template<int N, int Layer>
+        inline constexpr auto layer_cycles = make_layer_cycles<N, Layer>();
+
+        /* the kernel of move M: every cycle moves its stickers `power` steps forward. */
+        template<int N, int M>
+        constexpr void turn_layer(basic_cube<N>& c) {
+            constexpr int layer = M / 18, face = M / 3 % num_faces, power = M % 3 + 1;
+            constexpr auto& cycles = layer_cycles<N, layer>[face];
+            [&]<std::size_t... I>(std::index_sequence<I...>) {
+                ((void)[&] {
+                    constexpr sticker_cycle cy = cycles[I];
+                    const std::uint8_t s0 = c.stickers[cy[0]], s1 = c.stickers[cy[1]], s2 = c.stickers[cy[2]], s3 = c.stickers[cy[3]];
+                    c.stickers[cy[power % 4]] = s0;
+                    c.stickers[cy[(1 + power) % 4]] = s1;
+                    c.stickers[cy[(2 + power) % 4]] = s2;
+                    c.stickers[cy[(3 + power) % 4]] = s3;
+                }(), ...);
+            }(std::make_index_sequence<cycles.size()>{});
+        }
+
+        template<int N>
+        inline constexpr auto turn_kernels = []<std::size_t... M>(std::index_sequence<M...>) {
+            return std::array<void (*)(basic_cube<N>&), sizeof...(M)>{ &turn_layer<N, int(M)>... };
+        }(std::make_index_sequence<basic_cube<N>::num_moves>{});
+
+    }
+
+    /* applies move `m` (see layer_move()) to `c`. */
+    template<int N>
+    void apply_move(basic_cube<N>& c, int m)
+    { detail::turn_kernels<N>[m](c); }
+
+    template<int N>
+    void apply_move(basic_cube<N>& c, move_t m)
+    { detail::turn_kernels<N>[int(m)](c); }
+
+    template<int N>
+    void apply_sequence(basic_cube<N>& c, std::span<const move_t> seq) {
+        for (move_t m : seq)
+        { apply_move(c, m); }
+    }
+
+    template<int N>
+    std::ostream& operator<<(std::ostream& os, const basic_cube<N>& c) {
+        for (int i = 0; i < basic_cube<N>::num_stickers; ++i)
+        { os << "URFDLB"[c.stickers[i]]; }
+        return os;
+    }
+
+#ifdef BUILD_TESTS
+    int nxn_test(std::ostream& os);
+#endif
+
+}
+
+#endif
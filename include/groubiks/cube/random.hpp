@@ -0,0 +1,135 @@
+#ifndef GROUBIKS_CUBE_RANDOM_HPP
+#define GROUBIKS_CUBE_RANDOM_HPP
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <limits>
+#include <ostream>
+#include <span>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/coord.hpp>
+
+/**
+ * @file random.hpp
+ * @brief uniformly distributed random cube-states.
+ * @details a random-move scramble is neither uniform nor cheap. instead every coordinate
+ *          is drawn uniformly and unranked (see coord.hpp):
+ *          - the twist of the first 7 vertices and the flip of the first 11 edges,
+ *            the last orientation is implied by the others,
+ *          - both permutations, the edge-permutation with the parity of the vertex-permutation:
+ *            the lowest lehmer-digit only swaps the last two edges, so fixing it to the right
+ *            parity maps the ranks one-to-one onto the permutations of that parity.
+ *          so each of the 43252003274489856000 reachable states is equally likely.
+ *
+ *          the generator is xoshiro256**, seeded by splitmix64 and therefore fully determined
+ *          by a 64-bit seed. every thread should own one generator; stream() hands out
+ *          non-overlapping ones for the same seed.
+ */
+
+namespace groubiks {
+
+    class xoshiro256 {
+    public:
+        using result_type = std::uint64_t;
+
+        /* the state is filled by splitmix64 from `seed`, as recommended by the authors. */
+        explicit constexpr xoshiro256(std::uint64_t seed) {
+            for (std::uint64_t& s : m_state) {
+                seed += 0x9e3779b97f4a7c15ull;
+                std::uint64_t z = seed;
+                z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ull;
+                z = (z ^ (z >> 27)) * 0x94d049bb133111ebull;
+                s = z ^ (z >> 31);
+            }
+        }
+
+        /* a raw state, which must not be all zeros. */
+        explicit constexpr xoshiro256(const std::array<std::uint64_t, 4>& state)
+            : m_state(state) {}
+
+        /**
+         * @returns generator number `index` of `seed`: the generator of `seed` advanced by
+         *          index * 2^128 numbers, so streams of one seed never overlap in practice.
+         */
+        static constexpr xoshiro256 stream(std::uint64_t seed, unsigned index) {
+            xoshiro256 res(seed);
+            for (unsigned i = 0; i < index; ++i)
+            { res.jump(); }
+            return res;
+        }
+
+        static constexpr result_type min() { return 0; }
+        static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+        constexpr result_type operator()() {
+            const std::uint64_t res = std::rotl(m_state[1] * 5, 7) * 9;
+            const std::uint64_t t = m_state[1] << 17;
+            m_state[2] ^= m_state[0];
+            m_state[3] ^= m_state[1];
+            m_state[1] ^= m_state[2];
+            m_state[0] ^= m_state[3];
+            m_state[2] ^= t;
+            m_state[3] = std::rotl(m_state[3], 45);
+            return res;
+        }
+
+        /* @returns a uniform number in [0, n), n > 0 (lemire's multiply-and-reject). */
+        constexpr std::uint64_t below(std::uint64_t n) {
+            unsigned __int128 m = (unsigned __int128)(*this)() * n;
+            if (std::uint64_t(m) < n) {
+                const std::uint64_t threshold = (0 - n) % n;
+                while (std::uint64_t(m) < threshold)
+                { m = (unsigned __int128)(*this)() * n; }
+            }
+            return std::uint64_t(m >> 64);
+        }
+
+        /* advances the generator by 2^128 numbers. */
+        constexpr void jump() {
+            constexpr std::uint64_t polynomial[] = { 0x180ec6d33cfd0aba, 0xd5a61266f0c9392c, 0xa9582618e03fc9aa, 0x39abdc4529b1661c };
+            std::array<std::uint64_t, 4> res{};
+            for (std::uint64_t word : polynomial) {
+                for (int bit = 0; bit < 64; ++bit) {
+                    if (word & std::uint64_t(1) << bit) {
+                        for (int i = 0; i < 4; ++i)
+                        { res[i] ^= m_state[i]; }
+                    }
+                    (*this)();
+                }
+            }
+            m_state = res;
+        }
+
+    private:
+        std::array<std::uint64_t, 4> m_state;
+    };
+
+    /* @returns a uniformly distributed solvable cube. */
+    constexpr cube random_cube(xoshiro256& rng) {
+        const coord::coord_t vertex_perm = coord::coord_t(rng.below(coord::num_vertex_perms));
+        /* the lowest digit of a lehmer-rank swaps the last two pieces, it is set to match the parities. */
+        coord::coord_t edge_perm = coord::coord_t(rng.below(coord::num_edge_perms / 2)) * 2;
+        edge_perm |= coord::detail::rank_parity<cube::num_vertices>(vertex_perm) ^
+                     coord::detail::rank_parity<cube::num_edges>(edge_perm);
+        cube res = cube::get_solved();
+        coord::set_vertex_perm(res, vertex_perm);
+        coord::set_edge_perm(res, edge_perm);
+        coord::set_vertex_twist(res, coord::coord_t(rng.below(coord::num_vertex_twists)));
+        coord::set_edge_flip(res, coord::coord_t(rng.below(coord::num_edge_flips)));
+        return res;
+    }
+
+    /**
+     * @brief fills `out` with random_cube(rng), without allocating.
+     *        the same generator-state yields the same cubes in the same order.
+     */
+    void random_cubes(xoshiro256& rng, std::span<cube> out);
+
+#ifdef BUILD_TESTS
+    int random_test(std::ostream& os);
+#endif
+
+}
+
+#endif
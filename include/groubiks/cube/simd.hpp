@@ -0,0 +1,61 @@
+
+#ifndef GROUBIKS_CUBE_SIMD_HPP
+#define GROUBIKS_CUBE_SIMD_HPP
+
+#include <span>
+#include <string_view>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file simd.hpp
+ * @brief vectorized move-application, selected at runtime by cpu-feature detection.
+ * @details a face-turn on unpacked pieces (one byte per piece, orientation in bits 4..5)
+ *          is a single byte-shuffle (pshufb) with the move's permutation, followed
+ *          by an add/compare/subtract for the orientations.
+ *          vertices are already stored one byte per slot, the 5-bit edge-fields get
+ *          expanded to bytes (pdep with bmi2) before and compressed (pext) after the move.
+ *          all kernels produce bit-identical results to groubiks::apply_move().
+ */
+
+/* the x86 kernels need gcc/clang function-level target-attributes. */
+#if (defined(__GNUC__) || defined(__clang__)) && defined(__x86_64__)
+    #define GROUBIKS_SIMD_X86
+#endif
+
+namespace groubiks::simd {
+
+    enum class kernel_t {
+        scalar, /* groubiks::apply_move(), always available */
+        ssse3,  /* two 128-bit shuffles, edges are unpacked in software */
+        avx2    /* one 256-bit shuffle, edges are unpacked with bmi2 pdep/pext */
+    };
+
+    std::string_view kernel_name(kernel_t k);
+    bool kernel_supported(kernel_t k);
+    /**
+     * @returns the kernel used by apply_move()/apply_sequence().
+     *          defaults to the best kernel supported by the cpu.
+     */
+    kernel_t active_kernel();
+    /**
+     * @brief overrides the detected kernel, e.g. to compare kernels against each other.
+     *        not thread-safe, call before any thread uses the kernels.
+     * @returns false (and leaves the kernel unchanged) if the cpu does not support `k`.
+     */
+    bool select_kernel(kernel_t k);
+
+    void apply_move(cube& c, move_t m);
+    /**
+     * @brief applies a whole sequence. the cube stays unpacked in registers
+     *        in between moves, so this is much faster than repeated apply_move().
+     */
+    void apply_sequence(cube& c, std::span<const move_t> seq);
+
+#ifdef BUILD_TESTS
+    int simd_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,146 @@
+#ifndef GROUBIKS_CUBE_SYMMETRY_HPP
+#define GROUBIKS_CUBE_SYMMETRY_HPP
+
+#include <array>
+#include <cstdint>
+#include <ostream>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file symmetry.hpp
+ * @brief the 48 symmetries of the cube, i.e. the rotations and reflections that map it onto itself.
+ * @details symmetry s = 16 * a + 8 * b + 2 * c + d is the product URF3^a * F2^b * U4^c * LR2^d of
+ *          URF3: the 120-degree rotation around the URF-DBL-diagonal,
+ *          F2:   the 180-degree rotation around the F-B-axis,
+ *          U4:   the 90-degree rotation around the U-D-axis,
+ *          LR2:  the reflection at the plane between L and R.
+ *          the first 16 symmetries (a = 0) keep the U-D-axis in place.
+ *
+ *          conjugating a cube with a symmetry shows the same state from another side
+ *          (or in a mirror). every move conjugates into a move, so all 48 conjugates
+ *          of a cube are exactly as far from solved, which lets distance-tables store
+ *          a single entry per class of symmetric states.
+ *          a reflection reverses the direction of all twists, so it is no cube itself:
+ *          symmetries are stored as their rotation and a mirror-flag.
+ */
+
+namespace groubiks {
+
+    inline constexpr int num_symmetries = 48;
+    inline constexpr int num_ud_symmetries = 16;
+
+    namespace detail {
+
+        constexpr cube symmetry_urf3 = make_cube({ 0, 4, 5, 1, 3, 7, 6, 2 }, { 1, 2, 1, 2, 2, 1, 2, 1 },
+            { 1, 8, 5, 9, 3, 11, 7, 10, 0, 4, 6, 2 }, { 1, 0, 1, 0, 1, 0, 1, 0, 1, 1, 1, 1 });
+        constexpr cube symmetry_f2 = make_cube({ 5, 4, 7, 6, 1, 0, 3, 2 }, { 0, 0, 0, 0, 0, 0, 0, 0 },
+            { 6, 5, 4, 7, 2, 1, 0, 3, 9, 8, 11, 10 }, { 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0 });
+        constexpr cube symmetry_u4 = make_cube({ 3, 0, 1, 2, 7, 4, 5, 6 }, { 0, 0, 0, 0, 0, 0, 0, 0 },
+            { 3, 0, 1, 2, 7, 4, 5, 6, 11, 8, 9, 10 }, { 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 1, 1 });
+
+        /* LR2 swaps the L- and R-side of every slot (it is its own inverse). */
+        constexpr int mirror_vertices[cube::num_vertices] = { 1, 0, 3, 2, 5, 4, 7, 6 };
+        constexpr int mirror_edges[cube::num_edges] = { 2, 1, 0, 3, 6, 5, 4, 7, 9, 8, 11, 10 };
+
+        /* LR2 * c * LR2: the pieces trade places with their mirror-images, twists change their direction. */
+        constexpr cube mirror(const cube& c) {
+            cube res{ 0, 0 };
+            for (int i = 0; i < cube::num_vertices; ++i) {
+                const int from = mirror_vertices[i];
+                const int twist = c.vertex_twist(from);
+                res.set_vertex(i, mirror_vertices[c.vertex(from)], twist == 0 ? 0 : 3 - twist);
+            }
+            for (int i = 0; i < cube::num_edges; ++i) {
+                const int from = mirror_edges[i];
+                res.set_edge(i, mirror_edges[c.edge(from)], c.edge_flip(from));
+            }
+            return res;
+        }
+
+        /* the rotation URF3^a * F2^b * U4^c of symmetry 2 * (8 * a + 4 * b + c). */
+        constexpr std::array<cube, num_symmetries / 2> make_symmetry_rotations() {
+            std::array<cube, num_symmetries / 2> res{};
+            cube a = cube::get_solved();
+            for (int i = 0; i < 3; ++i) {
+                cube b = a;
+                for (int j = 0; j < 2; ++j) {
+                    cube c = b;
+                    for (int k = 0; k < 4; ++k) {
+                        res[8 * i + 4 * j + k] = c;
+                        c = multiply(c, symmetry_u4);
+                    }
+                    b = multiply(b, symmetry_f2);
+                }
+                a = multiply(a, symmetry_urf3);
+            }
+            return res;
+        }
+
+        inline constexpr std::array<cube, num_symmetries / 2> symmetry_rotations = make_symmetry_rotations();
+
+    }
+
+    /**
+     * @returns S * c * S^-1 for the symmetry S with index s (0..47),
+     *          i.e. c as seen after rotating (and reflecting) the cube by S^-1.
+     */
+    constexpr cube conjugate(const cube& c, int s) {
+        const cube& r = detail::symmetry_rotations[s / 2];
+        return multiply(multiply(r, s % 2 == 0 ? c : detail::mirror(c)), inverse(r));
+    }
+
+    namespace detail {
+
+        /* [s][m]: the move that conjugate() turns move m into, 0xff if there is none (a bug). */
+        constexpr std::array<std::array<std::uint8_t, num_moves>, num_symmetries> make_symmetry_moves() {
+            std::array<std::array<std::uint8_t, num_moves>, num_symmetries> res{};
+            for (int s = 0; s < num_symmetries; ++s) {
+                for (int m = 0; m < num_moves; ++m) {
+                    const cube x = conjugate(move_cubes[m], s);
+                    res[s][m] = 0xff;
+                    for (int k = 0; k < num_moves; ++k) {
+                        if (move_cubes[k] == x)
+                        { res[s][m] = std::uint8_t(k); }
+                    }
+                }
+            }
+            return res;
+        }
+
+        inline constexpr std::array<std::array<std::uint8_t, num_moves>, num_symmetries> symmetry_moves = make_symmetry_moves();
+
+        /* a symmetry is determined by its action on the moves, so the inverse is the one undoing it. */
+        constexpr std::array<std::uint8_t, num_symmetries> make_inverse_symmetries() {
+            std::array<std::uint8_t, num_symmetries> res{};
+            for (int s = 0; s < num_symmetries; ++s) {
+                for (int t = 0; t < num_symmetries; ++t) {
+                    bool undoes = true;
+                    for (int m = 0; m < num_moves; ++m)
+                    { undoes = undoes && symmetry_moves[t][symmetry_moves[s][m] % num_moves] == m; }
+                    if (undoes)
+                    { res[s] = std::uint8_t(t); }
+                }
+            }
+            return res;
+        }
+
+        inline constexpr std::array<std::uint8_t, num_symmetries> inverse_symmetries = make_inverse_symmetries();
+
+    }
+
+    /* the move m becomes under conjugate(), i.e. conjugate(move_cubes[m], s) == move_cubes[result]. */
+    constexpr move_t conjugate_move(move_t m, int s)
+    { return move_t(detail::symmetry_moves[s][std::uint8_t(m)]); }
+
+    /* the symmetry t with conjugate(conjugate(c, s), t) == c. */
+    constexpr int inverse_symmetry(int s)
+    { return detail::inverse_symmetries[s]; }
+
+#ifdef BUILD_TESTS
+    int symmetry_test(std::ostream& os);
+#endif
+
+}
+
+#endif
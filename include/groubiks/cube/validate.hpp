@@ -0,0 +1,55 @@
+#ifndef GROUBIKS_CUBE_VALIDATE_HPP
+#define GROUBIKS_CUBE_VALIDATE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/batch.hpp>
+
+/**
+ * @file validate.hpp
+ * @brief checks whether cubes from outside (files, other programs) are solvable.
+ * @details a cube is solvable exactly if its pieces form two permutations of equal parity,
+ *          the twists sum to 0 mod 3 and the flips sum to 0 mod 2. anything else is reported
+ *          as a bitmask of the validation_error below, 0 meaning the cube is solvable.
+ *
+ *          batches are checked 32 cubes at a time (avx2, if selected by simd::active_kernel()):
+ *          a byte-lookup (pshufb) turns every piece into its bit in the set of pieces,
+ *          the orientation-sums are byte-adds and the parity is the xor of all 28 + 66
+ *          comparisons p[i] > p[j] of the permutations.
+ */
+
+namespace groubiks {
+
+    enum validation_error : std::uint8_t {
+        /* a piece or orientation outside of its range, or stray bits set */
+        invalid_field = 1 << 0,
+        /* a piece occurs twice, so another one is missing */
+        duplicate_piece = 1 << 1,
+        /* the vertex-twists do not sum to 0 mod 3 */
+        twisted_vertex = 1 << 2,
+        /* the edge-flips do not sum to 0 mod 2 */
+        flipped_edge = 1 << 3,
+        /* vertex- and edge-permutation differ in parity. only checked for valid permutations. */
+        odd_permutation = 1 << 4
+    };
+
+    /* @returns the validation_error-bits of `c`, 0 if it is solvable. */
+    std::uint8_t validate(const cube& c);
+
+    /**
+     * @brief writes the validation_error-bits of every cube of `batch` to `errors[k]`,
+     *        which must hold at least batch.size() bytes.
+     * @returns the number of cubes that are not solvable.
+     */
+    std::size_t validate(const cube_batch& batch, std::span<std::uint8_t> errors);
+
+#ifdef BUILD_TESTS
+    int validate_test(std::ostream& os);
+#endif
+
+}
+
+#endif
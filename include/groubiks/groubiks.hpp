@@ -2,15 +2,16 @@
 #ifndef GROUBIKS_HPP
 #define GROUBIKS_HPP
 
+#include <groubiks/cube.hpp>
+#include <groubiks/gui.hpp>
+
+/* after all c++-headers, common.h defines macros like clamp(). */
 extern "C" {
     #include <groubiks/utility/dynarray.h>
     #include <groubiks/utility/common.h>
     // #include <groubiks/renderer/vulkan_context.h>
 }
 
-#include <groubiks/cube.hpp>
-#include <groubiks/gui.hpp>
-
 namespace groubiks {
 
     using result_type = int;
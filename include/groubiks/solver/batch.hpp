@@ -0,0 +1,86 @@
+#ifndef GROUBIKS_SOLVER_BATCH_HPP
+#define GROUBIKS_SOLVER_BATCH_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <string_view>
+#include <vector>
+#include <groubiks/cube.hpp>
+#include <groubiks/solver/bidirectional.hpp>
+#include <groubiks/solver/kociemba.hpp>
+
+/**
+ * @file batch.hpp
+ * @brief solving a stream of cubes without any user-interface (groubiks --batch).
+ * @details every non-empty input line is one cube, either a scramble in standard notation
+ *          ("R U2 F'") applied to the solved cube, or its 54 facelets as face-letters
+ *          ("UUUUUUUUURRR...", see facelets.hpp). lines starting with '#' are comments.
+ *
+ *          the worker-threads take turns reading the next line, solve it and write the
+ *          result; results that are ready before all earlier lines are held back, so the
+ *          output has exactly one line per input line, in input order:
+ *          the solution, or "error: <reason>". at most 4 lines per thread are read ahead
+ *          of the first unwritten one.
+ *
+ *          with a bidirectional solver, every state is first tried with it, which is cheap and
+ *          optimal for states close to solved: up to optimal_length moves, or up to the length
+ *          of its scramble if that is at most optimal_scramble_length. a state not solved within
+ *          these limits goes to the two-phase solver.
+ */
+
+namespace groubiks::solver {
+
+    struct batch_config {
+        /* 0: one per hardware-thread. */
+        int threads = 0;
+        int max_length = 22;
+        std::chrono::milliseconds timeout = std::chrono::seconds(5);
+        /* probe of the bidirectional solver, about 13.35^(optimal_length - depth) lookups. */
+        int optimal_length = 8;
+        /* scrambles up to this length are certainly solved by the bidirectional solver. */
+        int optimal_scramble_length = 10;
+    };
+
+    struct batch_report {
+        std::size_t states = 0;
+        /* unreadable or invalid states and those without solution within max_length. */
+        std::size_t failed = 0;
+        /* solved (optimally) by the bidirectional solver. */
+        std::size_t optimal = 0;
+        double seconds = 0.0;
+        /* the solve-time of every readable state, sorted. */
+        std::vector<double> latencies;
+
+        double states_per_second() const
+        { return seconds > 0.0 ? double(states) / seconds : 0.0; }
+        /* the latency below which a fraction `p` (0..1) of the states were solved. */
+        double latency_percentile(double p) const;
+    };
+
+    /* prints throughput and latency-percentiles of a batch. */
+    std::ostream& operator<<(std::ostream& os, const batch_report& r);
+
+    /**
+     * @brief reads one input line: a scramble or 54 face-letters.
+     * @param scramble_length set to the number of moves of a scramble, -1 for facelets.
+     * @returns nothing if the line is neither. the cube is not validated.
+     */
+    std::optional<cube> parse_state(std::string_view line, int* scramble_length = nullptr);
+
+    /**
+     * @brief solves every line of `in`, writing the results to `out` in input order.
+     *        `short_solver` (optional) takes the states close to solved, see above.
+     */
+    batch_report solve_batch(const kociemba& engine, std::istream& in, std::ostream& out, const batch_config& config = {},
+        const bidirectional* short_solver = nullptr);
+
+#ifdef BUILD_TESTS
+    int batch_test(std::ostream& os);
+#endif
+
+}
+
+#endif
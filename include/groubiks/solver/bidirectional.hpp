@@ -0,0 +1,68 @@
+#ifndef GROUBIKS_SOLVER_BIDIRECTIONAL_HPP
+#define GROUBIKS_SOLVER_BIDIRECTIONAL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <memory>
+#include <groubiks/cube.hpp>
+#include <groubiks/solver/solution.hpp>
+
+/**
+ * @file bidirectional.hpp
+ * @brief optimal solver (half-turn-metric) for cubes close to solved, meeting in the middle.
+ * @details every state within `depth` moves of solved is generated once, by a breadth-first
+ *          search from the solved cube, and kept in a hash-table with its distance and the move
+ *          that brings it one step closer to solved.
+ *          a query looks up the cube itself and then searches forward with iterative deepening:
+ *          iteration L expands the canonical sequences of L - depth moves (successor_moves in
+ *          moves.hpp) and looks up their end-states. the forward search is pruned with the small
+ *          distance-tables of phase 1 of the two-phase solver, which are lower bounds of the
+ *          distance to solved as well. the first hit is optimal, the backward half of the
+ *          solution is read from the table.
+ *
+ *          tables take well under a second and a few tens of MB, against several seconds and
+ *          far more memory for the pattern-databases of optimal.hpp, and a state within
+ *          depth + 3 moves is solved in well under a millisecond. beyond that every move costs
+ *          roughly a factor 5-10, so deeper states are better left to optimal.hpp.
+ *          states within depth (half-turn-metric), with the table:
+ *          4: 46741 (2.2 MB), 5: 621649 (18 MB), 6: 8240087 (285 MB), plus 6 MB of pruning-tables.
+ */
+
+namespace groubiks::solver {
+
+    struct bidirectional_tables;
+
+    class bidirectional {
+    public:
+        static constexpr int max_depth = 6;
+
+        /**
+         * @brief generates the states within `depth` moves of solved (clamped to 1..max_depth).
+         *        immutable afterwards, so one solver can be shared by any number of threads.
+         */
+        explicit bidirectional(int depth = 5);
+        ~bidirectional();
+
+        /**
+         * @brief searches for an optimal solution of at most `max_length` moves.
+         * @returns a solution with found unset if there is none within max_length
+         *          or the timeout expired.
+         */
+        solution solve(const cube& c, int max_length, std::chrono::milliseconds timeout) const;
+
+        int depth() const;
+        /* states in the table. */
+        std::size_t size() const;
+        std::size_t table_bytes() const;
+
+    private:
+        std::unique_ptr<const bidirectional_tables> m_tables;
+    };
+
+#ifdef BUILD_TESTS
+    int bidirectional_test(std::ostream& os);
+#endif
+
+}
+
+#endif
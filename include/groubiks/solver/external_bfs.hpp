@@ -0,0 +1,215 @@
+#ifndef GROUBIKS_SOLVER_EXTERNAL_BFS_HPP
+#define GROUBIKS_SOLVER_EXTERNAL_BFS_HPP
+
+#include <algorithm>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <fstream>
+#include <future>
+#include <ostream>
+#include <string>
+#include <vector>
+
+/**
+ * @file external_bfs.hpp
+ * @brief breadth-first search over state-spaces too large for memory, with the levels on disk.
+ * @details states are ranks (any 64-bit number, the space does not have to be dense), their
+ *          neighbours come from an expand-callback like the one of generate_table().
+ *          every level is a file of its ranks in ascending order, stored as the differences of
+ *          consecutive ranks in a variable-length code (7 bits per byte), which takes 1-2 bytes
+ *          per state in dense levels. all files are read and written strictly sequentially.
+ *
+ *          level d + 1 is found by delayed duplicate-detection:
+ *          - the neighbours of level d are collected in memory, sorted and written as runs.
+ *            a full buffer is sorted and written by a second thread while the next one fills.
+ *          - the runs are merged (in several passes if there are more than max_merge_runs) by
+ *            a tournament-tree and, in the same pass, levels d and d - 1 are subtracted.
+ *          this needs only the two previous levels because every move must have its inverse in
+ *          the move-set (true for all face-turn sets of the cube): a neighbour of level d lies in
+ *          level d - 1, d or d + 1.
+ *
+ *          after every level a manifest with the histogram so far is written (atomically), and
+ *          a search started on the same directory and start-state resumes after the last
+ *          complete level.
+ */
+
+namespace groubiks::solver {
+
+    struct external_bfs_config {
+        /* levels, runs and the manifest. created if missing. */
+        std::filesystem::path directory;
+        /* for sorting the neighbours: memory_bytes / 24 ranks per run (a buffer being filled, one being written, a scratch-buffer). */
+        std::size_t memory_bytes = std::size_t(256) << 20;
+        /* runs merged at once. each needs an open file and an io-buffer. */
+        int max_merge_runs = 64;
+        /* stops after this level even if the next one is not empty. */
+        int max_depth = 64;
+        /* for logging (log.h), as in generator_config. nullptr: no logging. */
+        const char* name = nullptr;
+    };
+
+    struct external_bfs_result {
+        /* histogram[d]: states at distance d from the start. */
+        std::vector<std::uint64_t> histogram;
+        /* the last level had no successors. false after max_depth or an io-error. */
+        bool complete = false;
+        bool io_error = false;
+        /* of this run only, resumed levels are not counted. */
+        std::uint64_t bytes_read = 0;
+        std::uint64_t bytes_written = 0;
+        double seconds = 0.0;
+
+        std::uint64_t states() const;
+        double megabytes_per_second() const
+        { return seconds > 0.0 ? double(bytes_read + bytes_written) / seconds / 1e6 : 0.0; }
+    };
+
+    /* prints the histogram and the io-statistics. */
+    std::ostream& operator<<(std::ostream& os, const external_bfs_result& r);
+
+    /**
+     * @brief sequential writer of a strictly ascending sequence of ranks.
+     */
+    class rank_writer {
+    public:
+        explicit rank_writer(const std::filesystem::path& path);
+
+        void push(std::uint64_t rank);
+        /* @returns false if any write failed. */
+        bool close();
+
+        std::uint64_t count() const { return m_count; }
+        std::uint64_t bytes() const { return m_bytes; }
+
+    private:
+        void flush();
+
+        std::ofstream m_out;
+        std::vector<std::uint8_t> m_buffer;
+        std::size_t m_used = 0;
+        std::uint64_t m_last = 0;
+        std::uint64_t m_count = 0;
+        std::uint64_t m_bytes = 0;
+    };
+
+    /**
+     * @brief sequential reader of a file of rank_writer.
+     */
+    class rank_reader {
+    public:
+        explicit rank_reader(const std::filesystem::path& path, std::size_t buffer_bytes = std::size_t(1) << 20);
+
+        /* @returns false at the end of the file (or on an error, see failed()). */
+        bool next(std::uint64_t& rank) {
+            std::uint64_t delta = 0;
+            for (int shift = 0;; shift += 7) {
+                if (m_pos == m_end && !refill())
+                { return false; }
+                const std::uint8_t byte = m_buffer[m_pos++];
+                delta |= std::uint64_t(byte & 0x7f) << shift;
+                if (!(byte & 0x80))
+                { break; }
+            }
+            m_last += delta;
+            rank = m_last;
+            return true;
+        }
+
+        bool failed() const { return m_failed; }
+        std::uint64_t bytes() const { return m_bytes; }
+
+    private:
+        bool refill();
+
+        std::ifstream m_in;
+        std::vector<std::uint8_t> m_buffer;
+        std::size_t m_pos = 0;
+        std::size_t m_end = 0;
+        std::uint64_t m_last = 0;
+        std::uint64_t m_bytes = 0;
+        bool m_failed = false;
+    };
+
+    class external_bfs {
+    public:
+        explicit external_bfs(const external_bfs_config& config);
+
+        /**
+         * @brief searches from `start`, or resumes a search from `start` in the directory.
+         * @param expand called as expand(rank, visit) for every state of a level, calls visit(rank)
+         *        for every neighbour. its return value is ignored.
+         */
+        template<class Expand>
+        external_bfs_result run(std::uint64_t start, Expand&& expand) {
+            const auto begin_time = clock_type::now();
+            if (!begin(start))
+            { return finish(begin_time); }
+            while (!m_result.complete && !m_result.io_error && depth() < m_config.max_depth) {
+                rank_reader frontier(level_path(depth()));
+                std::vector<std::uint64_t> buffer;
+                buffer.reserve(run_capacity());
+                for (std::uint64_t rank; frontier.next(rank);) {
+                    expand(rank, [&](std::uint64_t n) {
+                        buffer.push_back(n);
+                        if (buffer.size() == run_capacity())
+                        { write_run(buffer); }
+                        return false;
+                    });
+                }
+                m_result.bytes_read += frontier.bytes();
+                m_result.io_error |= frontier.failed();
+                write_run(buffer);
+                finish_level();
+            }
+            return finish(begin_time);
+        }
+
+    private:
+        using clock_type = std::chrono::steady_clock;
+
+        int depth() const { return int(m_result.histogram.size()) - 1; }
+        std::size_t run_capacity() const
+        { return std::max<std::size_t>(m_config.memory_bytes / (3 * sizeof(std::uint64_t)), 1024); }
+        std::filesystem::path level_path(int depth) const;
+        std::filesystem::path run_path(int run) const;
+
+        /* resumes from the manifest, or writes level 0. @returns false on an io-error. */
+        bool begin(std::uint64_t start);
+        struct run_written {
+            std::uint64_t bytes = 0;
+            bool error = false;
+        };
+
+        /**
+         * @brief hands the buffer over to a thread that sorts it, drops duplicates and writes it
+         *        as the next run, and leaves the caller an empty buffer to fill meanwhile.
+         */
+        void write_run(std::vector<std::uint64_t>& buffer);
+        /* waits for the run being written. */
+        void wait_run();
+        /* merges the runs into the next level and checkpoints it. */
+        void finish_level();
+        bool write_manifest() const;
+        external_bfs_result finish(clock_type::time_point begin_time);
+
+        external_bfs_config m_config;
+        external_bfs_result m_result;
+        std::uint64_t m_start = 0;
+        int m_num_runs = 0;
+        /* runs are numbered on, so the files of merged runs can be told from fresh ones. */
+        int m_first_run = 0;
+        /* the run being sorted and written, and its sort-buffer. */
+        std::vector<std::uint64_t> m_writing;
+        std::vector<std::uint64_t> m_scratch;
+        std::future<run_written> m_writer;
+    };
+
+#ifdef BUILD_TESTS
+    int external_bfs_test(std::ostream& os);
+#endif
+
+}
+
+#endif
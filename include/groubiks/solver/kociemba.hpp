@@ -0,0 +1,72 @@
+
+#ifndef GROUBIKS_SOLVER_KOCIEMBA_HPP
+#define GROUBIKS_SOLVER_KOCIEMBA_HPP
+
+#include <chrono>
+#include <filesystem>
+#include <memory>
+#include <groubiks/cube.hpp>
+#include <groubiks/solver/solution.hpp>
+
+/**
+ * @file kociemba.hpp
+ * @brief two-phase solver after herbert kociemba.
+ * @details phase 1 brings the cube into the subgroup G1 = <U, D, R2, L2, F2, B2>
+ *          (all twists and flips zero, ud-slice-edges in the ud-slice),
+ *          phase 2 solves the cube within G1.
+ *          both phases are iterative-deepening searches over coordinates
+ *          (coord.hpp), moved through precomputed coordinate move-tables and pruned
+ *          with distance-tables:
+ *          phase 1: the exact distance to G1 over (flip, ud-slice, twist), one entry per twist and class
+ *          of (flip, ud-slice) under the 16 symmetries that keep the U-D-axis (70 MB),
+ *          phase 2: (slice-perm, vertex-perm) and (slice-perm, ud-edge-perm).
+ *          phase-1 solutions are tried shortest first and every one of them is
+ *          completed by phase 2, so the total length shrinks the longer the search runs.
+ *          the search alternates between the cube rotated onto each of its three axes
+ *          and their inverses, which finds short solutions considerably earlier.
+ *
+ *          on one core of a slow machine, at most 20 moves take about 10 ms on average.
+ *          at most 19 moves take under 20 ms for half of the random states, but a few need
+ *          seconds, which brings the average to 120-180 ms. a budget of 50 ms gives 19 moves
+ *          to two thirds of the states and 20 moves to the rest (19.0 moves on average).
+ */
+
+namespace groubiks::solver {
+
+    struct kociemba_tables;
+
+    class kociemba {
+    public:
+        /**
+         * @brief generates all move- and pruning-tables (78 MB, about 20 seconds on one core).
+         *        the tables are immutable afterwards, so one solver can be shared
+         *        by any number of threads.
+         */
+        kociemba();
+        /**
+         * @brief maps the tables from the table-file at `table_path` instead (see table_file.hpp),
+         *        which is generated first if it is missing or invalid.
+         *        `verify` checks the checksums, which reads the whole file once.
+         */
+        explicit kociemba(const std::filesystem::path& table_path, bool verify = true);
+        ~kociemba();
+
+        /**
+         * @brief searches for a solution of at most `max_length` moves.
+         * @details the search does not stop at its first solution, it keeps improving
+         *          the best one until it is short enough or `timeout` expires. on timeout
+         *          the best (too long) solution found so far is returned with found unset.
+         */
+        solution solve(const cube& c, int max_length, std::chrono::milliseconds timeout) const;
+
+    private:
+        std::unique_ptr<const kociemba_tables> m_tables;
+    };
+
+#ifdef BUILD_TESTS
+    int kociemba_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,128 @@
+#ifndef GROUBIKS_SOLVER_LAST_LAYER_HPP
+#define GROUBIKS_SOLVER_LAST_LAYER_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <istream>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+
+/**
+ * @file last_layer.hpp
+ * @brief database of last-layer-algorithms (OLL, PLL, ZBLL, ...), looked up by the state of the last layer.
+ * @details a cube whose first two layers (D-layer and ud-slice) are solved is in one of 62208
+ *          last-layer-states. ll_index() numbers them densely, a minimal perfect hash:
+ *          vertex-permutation (24), vertex-twist (27), edge-permutation of the same parity (12)
+ *          and edge-flip (8) of the U-layer.
+ *
+ *          every algorithm is added with all its variants: a U-turn before it (pre-AUF), the
+ *          algorithm performed from another side (y-rotation, i.e. conjugated with symmetry U4^r
+ *          of symmetry.hpp) and a U-turn after it (post-AUF). each variant solves one state,
+ *          which gets the variant in a flat table, so the normalisation under AUF and rotation is
+ *          paid once when the database is built, and a lookup is the index and one memory access.
+ *          a state that several variants solve keeps the one with the fewest moves (AUFs
+ *          included), then the one without rotation, then the earliest algorithm.
+ *
+ *          a second table holds, per orientation of the last layer (216), the shortest variant
+ *          that orients it. a state without an exact algorithm gets that one, so a file of
+ *          OLL- and PLL-algorithms solves every last layer in two looks.
+ */
+
+namespace groubiks::solver {
+
+    struct ll_algorithm {
+        std::string name;
+        /* the face-turns of the algorithm as written, rotations already resolved. */
+        std::vector<move_t> moves;
+    };
+
+    /* the variant of an algorithm that fits a state. */
+    struct ll_match {
+        const ll_algorithm* algorithm;
+        /* quarter-turns of U before the algorithm. */
+        int pre_auf;
+        /* cube-rotations y before the algorithm (the turns of moves() are already rotated back). */
+        int rotation;
+        /* quarter-turns of U after the algorithm. */
+        int post_auf;
+        /* false if the match only orients the last layer, the next lookup finds the rest. */
+        bool solves;
+    };
+
+    class last_layer_db {
+    public:
+        /* 4! * 3^3 * 4! / 2 * 2^3 */
+        static constexpr std::size_t num_states = 62208;
+        /* 3^3 * 2^3 */
+        static constexpr std::size_t num_orientations = 216;
+
+        /* holds only the empty algorithm ("skip"), which solves the states that only need an AUF. */
+        last_layer_db();
+
+        /**
+         * @brief adds an algorithm with all its variants.
+         * @returns false (and adds nothing) if it does not keep the first two layers.
+         */
+        bool add(std::string_view name, std::span<const move_t> moves);
+
+        /**
+         * @brief adds the algorithms of an algorithm-file: one per line, "name: moves" or just
+         *        the moves in standard notation (notation.hpp, rotations and wide moves allowed).
+         *        empty lines and lines starting with '#' are skipped.
+         * @returns the numbers (1-based) of the lines that are no last-layer-algorithm.
+         */
+        std::vector<std::size_t> read(std::istream& in);
+
+        /**
+         * @returns the algorithm for the last layer of `c`, or the one orienting it,
+         *          or nothing if the first two layers are unsolved or no algorithm fits.
+         */
+        std::optional<ll_match> find(const cube& c) const;
+
+        /* the turns of a match as applied to the cube: pre-AUF, the rotated algorithm and post-AUF. */
+        std::vector<move_t> moves(const ll_match& match) const;
+
+        const std::vector<ll_algorithm>& algorithms() const { return m_algorithms; }
+        /* the states solved by an algorithm of the database. */
+        std::size_t solved_states() const { return m_solved_states; }
+
+        /* true if everything but the U-layer is solved. */
+        static bool f2l_solved(const cube& c);
+        /* the index of the last-layer-state of `c`, whose first two layers must be solved. */
+        static std::size_t ll_index(const cube& c);
+        /* the index of its orientation only, 0 if the last layer is oriented. */
+        static std::size_t orientation_index(const cube& c);
+
+    private:
+        struct entry {
+            static constexpr std::uint16_t none = 0xffff;
+
+            std::uint16_t algorithm = none;
+            /* pre_auf | rotation << 2 | post_auf << 4 */
+            std::uint8_t variant = 0;
+            /* moves including AUFs, times 2, plus 1 with a rotation. */
+            std::uint8_t cost = 0xff;
+        };
+
+        static void store(entry& e, std::uint16_t algorithm, int pre_auf, int rotation, int post_auf, std::size_t length);
+        ll_match match(const entry& e, bool solves) const;
+
+        std::vector<ll_algorithm> m_algorithms;
+        std::vector<entry> m_states;
+        std::vector<entry> m_orientations;
+        std::size_t m_solved_states = 0;
+    };
+
+#ifdef BUILD_TESTS
+    int last_layer_test(std::ostream& os);
+#endif
+
+}
+
+#endif
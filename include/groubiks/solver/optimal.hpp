@@ -0,0 +1,106 @@
+
+#ifndef GROUBIKS_SOLVER_OPTIMAL_HPP
+#define GROUBIKS_SOLVER_OPTIMAL_HPP
+
+#include <chrono>
+#include <cstddef>
+#include <filesystem>
+#include <memory>
+#include <groubiks/cube.hpp>
+#include <groubiks/solver/solution.hpp>
+
+/**
+ * @file optimal.hpp
+ * @brief optimal solver (half-turn-metric) after richard korf.
+ * @details iterative-deepening A* over cube-states, each one held as coordinates (vertex-permutation,
+ *          vertex-twist and the position of every edge) and moved through coordinate move-tables
+ *          instead of permuting a whole cube (tables.hpp). the heuristic is the maximum over
+ *          pattern-databases, i.e. exact distance-tables of abstractions of the cube:
+ *          - corners: permutation and twist of all vertices, 8! * 3^7 entries (42 MB),
+ *            or one entry per class of symmetric states (2.9 MB, see pattern_config),
+ *          - two edge-groups: slots and flips of k edges each, the first k edges
+ *            (UR, UF, ...) and the last k edges (..., BL, BR), 12! / (12 - k)! * 2^k entries.
+ *          every table is admissible, so the first solution found is optimal.
+ *          tables store 4 bits per entry.
+ */
+
+namespace groubiks::solver {
+
+    struct optimal_tables;
+
+    /**
+     * @brief selects the pattern-databases, i.e. memory and generation-time against pruning.
+     *        edge-group-sizes (per table):
+     *        4: 190080 entries (93 KB), 5: 3041280 (1.5 MB), 6: 42577920 (20 MB),
+     *        7: 510935040 (244 MB). 0 disables the edge-tables, larger values are clamped to 7.
+     */
+    struct pattern_config {
+        bool corners = true;
+        int edge_group_size = 6;
+        /* threads generating the tables, 0: one per hardware-thread */
+        int generator_threads = 0;
+        /**
+         * stores the corner-table once per class of the 16 symmetries that keep the U-D-axis:
+         * 2768 * 3^7 entries (2.9 MB) instead of 8! * 3^7 (42 MB), at the cost of two
+         * small lookups (class and conjugated twist, about 150 KB) per probe.
+         */
+        bool corner_symmetry = true;
+    };
+
+    /**
+     * @brief a parallel search splits every iteration into the subtrees `split_depth` moves
+     *        below the cube and runs them on `threads` workers (0: one per hardware-thread),
+     *        which steal subtrees from each other once their own run out.
+     *        deeper splits balance better, but repeat more work above the split.
+     */
+    struct parallel_config {
+        int threads = 0;
+        int split_depth = 3;
+    };
+
+    class optimal {
+    public:
+        /**
+         * @brief generates the pattern-databases selected by `config`.
+         *        the full default set (44 MB) takes under a minute on one core,
+         *        almost all of it for the edge-tables.
+         */
+        explicit optimal(const pattern_config& config = {});
+        /**
+         * @brief maps the pattern-databases from the table-file at `table_path` (see table_file.hpp),
+         *        generating and writing it first if it is missing, invalid or lacks a table of `config`.
+         *        the default set then opens in well under a second instead of 30 s.
+         */
+        optimal(const pattern_config& config, const std::filesystem::path& table_path, bool verify = true);
+        ~optimal();
+
+        /**
+         * @brief searches for an optimal solution of at most `max_length` moves.
+         * @returns the solution with the number of expanded nodes, table-lookups and time.
+         *          found is unset if there is no solution within `max_length`
+         *          or the search did not finish within `timeout`.
+         */
+        solution solve(const cube& c, int max_length, std::chrono::milliseconds timeout) const;
+        /**
+         * @brief the same search on several threads. all workers share the current
+         *        iteration-bound, the first solution found cancels the others.
+         *        nodes and lookups are summed over all workers.
+         */
+        solution solve(const cube& c, int max_length, std::chrono::milliseconds timeout,
+            const parallel_config& parallel) const;
+
+        const pattern_config& config() const;
+        /* memory used by the pattern-databases. */
+        std::size_t table_bytes() const;
+
+    private:
+        std::unique_ptr<const optimal_tables> m_tables;
+    };
+
+#ifdef BUILD_TESTS
+    int optimal_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,36 @@
+
+#ifndef GROUBIKS_SOLVER_SOLUTION_HPP
+#define GROUBIKS_SOLVER_SOLUTION_HPP
+
+#include <cstdint>
+#include <ostream>
+#include <vector>
+#include <groubiks/cube/moves.hpp>
+
+namespace groubiks::solver {
+
+    /**
+     * @brief result of a solve-call, shared by all solvers.
+     */
+    struct solution {
+        /* the moves that solve the cube. only meaningful if found is set. */
+        std::vector<move_t> moves;
+        bool found = false;
+        /* search-statistics */
+        std::uint64_t nodes = 0;
+        /* pruning-table lookups, 0 if the solver does not count them. */
+        std::uint64_t lookups = 0;
+        double seconds = 0.0;
+
+        int length() const
+        { return int(moves.size()); }
+        double nodes_per_second() const
+        { return seconds > 0.0 ? double(nodes) / seconds : 0.0; }
+    };
+
+    /* prints the moves in standard notation, separated by spaces. */
+    std::ostream& operator<<(std::ostream& os, const solution& s);
+
+}
+
+#endif
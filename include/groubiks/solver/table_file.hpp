@@ -0,0 +1,103 @@
+
+#ifndef GROUBIKS_SOLVER_TABLE_FILE_HPP
+#define GROUBIKS_SOLVER_TABLE_FILE_HPP
+
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string>
+#include <string_view>
+#include <vector>
+
+/**
+ * @file table_file.hpp
+ * @brief binary file of named tables, memory-mapped read-only into the solvers.
+ * @details layout (little-endian, every offset a multiple of page_size):
+ *          - page 0: header { magic "GRBKTBL\0", version, num_sections, file_size,
+ *            directory_checksum } followed by the directory, one entry
+ *            { name[40], offset, size, checksum } per section.
+ *          - the sections, each starting on a page-boundary, padded with zeros.
+ *          a table in the file is used in place: the solver's tables point right into
+ *          the mapping, so opening a file only costs the checksum-pass (optional)
+ *          and the page-faults of the entries the search touches.
+ */
+
+namespace groubiks::solver {
+
+    class table_file {
+    public:
+        static constexpr std::uint32_t version = 1;
+        static constexpr std::size_t page_size = 4096;
+        static constexpr std::size_t max_name_length = 39;
+
+        /**
+         * @brief maps the file at `path`.
+         * @returns nothing if the file is missing, has another version or is truncated,
+         *          or (with `verify`) if a checksum does not match.
+         */
+        static std::optional<table_file> open(const std::filesystem::path& path, bool verify = true);
+
+        table_file(table_file&& other) noexcept;
+        table_file& operator=(table_file&& other) noexcept;
+        ~table_file();
+
+        /* @returns the bytes of section `name`, or nothing if there is none. */
+        std::optional<std::span<const std::uint8_t>> section(std::string_view name) const;
+        std::size_t size() const { return m_size; }
+
+    private:
+        struct entry {
+            std::string name;
+            std::span<const std::uint8_t> data;
+        };
+
+        table_file(const void* data, std::size_t size)
+            : m_data(data), m_size(size) {}
+
+        const void* m_data = nullptr;
+        std::size_t m_size = 0;
+        std::vector<entry> m_sections;
+    };
+
+    /**
+     * @brief collects sections and writes them as a table_file.
+     *        the data is not copied, it has to outlive write().
+     */
+    class table_file_writer {
+    public:
+        /* @returns false if the name is too long or already taken. */
+        bool add(std::string_view name, std::span<const std::uint8_t> data);
+
+        /**
+         * @brief writes to a temporary file next to `path` and renames it afterwards,
+         *        so concurrent readers never see a partial file.
+         * @returns false on any io-error.
+         */
+        bool write(const std::filesystem::path& path) const;
+
+    private:
+        struct entry {
+            std::string name;
+            std::span<const std::uint8_t> data;
+        };
+        std::vector<entry> m_sections;
+    };
+
+    /* the raw bytes of a table of trivially copyable elements. */
+    template<class T>
+    std::span<const std::uint8_t> as_table_bytes(std::span<const T> table)
+    { return { reinterpret_cast<const std::uint8_t*>(table.data()), table.size_bytes() }; }
+
+    /* 64-bit checksum of the table-file format. */
+    std::uint64_t table_checksum(std::span<const std::uint8_t> data);
+
+#ifdef BUILD_TESTS
+    int table_file_test(std::ostream& os);
+#endif
+
+}
+
+#endif
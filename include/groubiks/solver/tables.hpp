@@ -0,0 +1,498 @@
+
+#ifndef GROUBIKS_SOLVER_TABLES_HPP
+#define GROUBIKS_SOLVER_TABLES_HPP
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <filesystem>
+#include <optional>
+#include <ostream>
+#include <span>
+#include <string_view>
+#include <thread>
+#include <vector>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/symmetry.hpp>
+#include <groubiks/solver/table_file.hpp>
+#include <groubiks/solver/work_stealing.hpp>
+
+/**
+ * @file tables.hpp
+ * @brief move- and distance-tables shared by the solvers.
+ * @details a distance-table (pruning-table, pattern-database) holds the number of moves
+ *          from every index of a coordinate-space back to index 0 (solved).
+ *          it is generated by a level-synchronous breadth-first search on several threads,
+ *          see generate_table(), or mapped from a table_file, see load_or_generate().
+ */
+
+namespace groubiks::solver {
+
+    /**
+     * @brief order of the entries of a move-table.
+     *        coord_major: [c * num_moves + m], all successors of a coordinate share one or
+     *        two cache-lines, which suits searches that expand every move of a node.
+     *        move_major: [m * count + c], one contiguous row per move, which suits sweeps
+     *        that apply the same move to many coordinates, e.g. a whole batch or table.
+     */
+    enum class table_layout { coord_major, move_major };
+
+    /**
+     * @brief fills a move-table: the entry of (c, m) is coordinate c after moves[m].
+     */
+    template<class T, class Unrank, class Rank>
+    std::vector<T> build_move_table(coord::coord_t count, std::span<const move_t> moves, Unrank&& unrank, Rank&& rank,
+        table_layout layout = table_layout::coord_major)
+    {
+        std::vector<T> res(std::size_t(count) * moves.size());
+        for (coord::coord_t c = 0; c < count; ++c) {
+            cube base = cube::get_solved();
+            unrank(base, c);
+            for (std::size_t m = 0; m < moves.size(); ++m) {
+                cube moved = base;
+                apply_move(moved, moves[m]);
+                const std::size_t idx = layout == table_layout::coord_major ? c * moves.size() + m : m * count + c;
+                res[idx] = T(rank(moved));
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief fills a conjugation-table: table[c * num_syms + s] is coordinate c of
+     *        conjugate(cube, s), for the symmetries 0..num_syms-1.
+     *        only valid for coordinates whose conjugate does not depend on the rest of the cube,
+     *        e.g. vertex-permutations under all symmetries, or vertex-twists under
+     *        the num_ud_symmetries that keep the U-D-axis.
+     */
+    template<class T, class Unrank, class Rank>
+    std::vector<T> build_conjugation_table(coord::coord_t count, int num_syms, Unrank&& unrank, Rank&& rank) {
+        std::vector<T> res(std::size_t(count) * num_syms);
+        for (coord::coord_t c = 0; c < count; ++c) {
+            cube base = cube::get_solved();
+            unrank(base, c);
+            for (int s = 0; s < num_syms; ++s)
+            { res[std::size_t(c) * num_syms + s] = T(rank(conjugate(base, s))); }
+        }
+        return res;
+    }
+
+    /**
+     * @brief the classes of a coordinate under a group of symmetries, the first num_syms
+     *        of symmetry.hpp (16 or 48). a distance-table over (class, other coordinates)
+     *        is up to num_syms times smaller than one over the raw coordinate.
+     */
+    struct symmetry_classes {
+        /* per coordinate: its class, and a symmetry conjugating it into the representative. */
+        std::vector<std::uint16_t> class_of;
+        std::vector<std::uint8_t> symmetry_of;
+        /* per class: its smallest coordinate, so class 0 is the solved one. */
+        std::vector<coord::coord_t> representatives;
+        /**
+         * per class: bit s is set if symmetry s maps the representative onto itself.
+         * a state with a symmetric representative has several entries in a reduced table
+         * (one per conjugate by these symmetries), which all have to hold its distance.
+         */
+        std::vector<std::uint64_t> stabilizers;
+    };
+
+    /* sorts the coordinates 0..count-1 into classes, from a table of build_conjugation_table(). */
+    symmetry_classes build_symmetry_classes(coord::coord_t count, int num_syms, std::span<const std::uint16_t> conjugation);
+
+    /**
+     * @brief the same for coordinates too large for a conjugation-table, e.g. the product of
+     *        two coordinates: conjugate(c, s) is coordinate c of the conjugate by symmetry s.
+     *        it is only called for the representatives, about count / num_syms times num_syms.
+     */
+    template<class Conjugate>
+    symmetry_classes build_symmetry_classes_by(coord::coord_t count, int num_syms, Conjugate&& conjugate) {
+        constexpr std::uint16_t unassigned = 0xffff;
+        symmetry_classes res;
+        res.class_of.assign(count, unassigned);
+        res.symmetry_of.assign(count, 0);
+        for (coord::coord_t c = 0; c < count; ++c) {
+            if (res.class_of[c] != unassigned)
+            { continue; }
+            /* c is the smallest coordinate of a new class, conjugate(c, s) is turned back by s^-1. */
+            const auto cls = std::uint16_t(res.representatives.size());
+            res.representatives.push_back(c);
+            res.stabilizers.push_back(0);
+            for (int s = 0; s < num_syms; ++s) {
+                const coord::coord_t other = conjugate(c, s);
+                if (other == c)
+                { res.stabilizers.back() |= std::uint64_t(1) << s; }
+                if (res.class_of[other] == unassigned) {
+                    res.class_of[other] = cls;
+                    res.symmetry_of[other] = std::uint8_t(inverse_symmetry(s));
+                }
+            }
+        }
+        return res;
+    }
+
+    /**
+     * @brief read-only array, e.g. a move-table, that either owns its elements
+     *        or views them in a mapped table_file. move-only, a copy would
+     *        have to decide whether to share or to duplicate the elements.
+     */
+    template<class T>
+    class flat_table {
+    public:
+        flat_table() = default;
+        explicit flat_table(std::vector<T> elements)
+            : m_owned(std::move(elements)), m_data(m_owned) {}
+        explicit flat_table(std::span<const T> mapped)
+            : m_data(mapped) {}
+        flat_table(flat_table&&) = default;
+        flat_table& operator=(flat_table&&) = default;
+
+        const T& operator[](std::size_t idx) const
+        { return m_data[idx]; }
+
+        std::size_t size() const { return m_data.size(); }
+        std::span<const T> elements() const { return m_data; }
+
+    private:
+        std::vector<T> m_owned;
+        std::span<const T> m_data;
+    };
+
+    /**
+     * @brief move-table of one coordinate-type under `NumMoves` moves, so a search can move
+     *        a tuple of coordinates instead of a whole cube. layout and number of moves are
+     *        compile-time constants, a lookup is a multiply-add and a load.
+     *        the elements may be owned or mapped like those of flat_table.
+     */
+    template<class T, int NumMoves = num_moves, table_layout Layout = table_layout::coord_major>
+    class coord_move_table {
+    public:
+        static constexpr table_layout layout = Layout;
+
+        coord_move_table() = default;
+        coord_move_table(coord::coord_t count, flat_table<T> elements)
+            : m_count(count), m_elements(std::move(elements)) {}
+
+        /* coordinate c after the m-th move of the move-set the table was generated for. */
+        coord::coord_t next(coord::coord_t c, int m) const {
+            if constexpr (Layout == table_layout::coord_major)
+            { return m_elements[std::size_t(c) * NumMoves + m]; }
+            else
+            { return m_elements[std::size_t(m) * m_count + c]; }
+        }
+
+        coord::coord_t count() const { return m_count; }
+        std::size_t bytes() const { return m_elements.elements().size_bytes(); }
+        const flat_table<T>& elements() const { return m_elements; }
+        flat_table<T>& elements() { return m_elements; }
+
+    private:
+        coord::coord_t m_count = 0;
+        flat_table<T> m_elements;
+    };
+
+    /**
+     * @brief generates the move-table of a coordinate-type (coord.hpp) under `moves`,
+     *        e.g. generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves).
+     */
+    template<class T, int NumMoves, table_layout Layout = table_layout::coord_major>
+    coord_move_table<T, NumMoves, Layout> generate_move_table(const coord::coordinate& type, std::span<const move_t, NumMoves> moves) {
+        return coord_move_table<T, NumMoves, Layout>(type.count,
+            flat_table<T>(build_move_table<T>(type.count, moves, type.set, type.rank, Layout)));
+    }
+
+    /**
+     * @brief distance-table with one byte per index. unvisited indices hold 0xff.
+     *        get() is for searches on the finished table, the generator goes through
+     *        atomic_get() and set_if_unvisited(), which may run concurrently and only
+     *        work on owned tables, not on mapped ones.
+     */
+    class byte_table {
+    public:
+        static constexpr std::uint8_t unvisited = 0xff;
+
+        byte_table() = default;
+        explicit byte_table(std::size_t size)
+            : m_owned(size, unvisited), m_data(m_owned) {}
+        explicit byte_table(std::span<const std::uint8_t> mapped)
+            : m_data(mapped) {}
+        byte_table(byte_table&&) = default;
+        byte_table& operator=(byte_table&&) = default;
+
+        std::uint8_t get(std::size_t idx) const
+        { return m_data[idx]; }
+
+        std::uint8_t atomic_get(std::size_t idx)
+        { return std::atomic_ref(m_owned[idx]).load(std::memory_order_relaxed); }
+        /* @returns true if this call changed the entry. */
+        bool set_if_unvisited(std::size_t idx, std::uint8_t val) {
+            std::uint8_t expected = unvisited;
+            return std::atomic_ref(m_owned[idx]).compare_exchange_strong(expected, val, std::memory_order_relaxed);
+        }
+
+        std::size_t size() const { return m_data.size(); }
+        std::size_t bytes() const { return m_data.size(); }
+        std::span<const std::uint8_t> raw() const { return m_data; }
+
+    private:
+        std::vector<std::uint8_t> m_owned;
+        std::span<const std::uint8_t> m_data;
+    };
+
+    /**
+     * @brief distance-table with 4 bits per index, for the large pattern-databases.
+     *        distances are at most 14, 0xf marks unvisited indices.
+     *        two indices share a byte, so concurrent updates compare-and-swap the whole byte.
+     */
+    class nibble_table {
+    public:
+        static constexpr std::uint8_t unvisited = 0xf;
+
+        static constexpr std::size_t bytes_for(std::size_t size)
+        { return (size + 1) / 2; }
+
+        nibble_table() = default;
+        explicit nibble_table(std::size_t size)
+            : m_size(size), m_owned(bytes_for(size), 0xff), m_data(m_owned) {}
+        /* `mapped` must hold bytes_for(size) bytes. */
+        nibble_table(std::span<const std::uint8_t> mapped, std::size_t size)
+            : m_size(size), m_data(mapped) {}
+        nibble_table(nibble_table&&) = default;
+        nibble_table& operator=(nibble_table&&) = default;
+
+        std::uint8_t get(std::size_t idx) const
+        { return (m_data[idx >> 1] >> ((idx & 1) * 4)) & 0xf; }
+
+        std::uint8_t atomic_get(std::size_t idx) {
+            const std::uint8_t byte = std::atomic_ref(m_owned[idx >> 1]).load(std::memory_order_relaxed);
+            return (byte >> ((idx & 1) * 4)) & 0xf;
+        }
+        bool set_if_unvisited(std::size_t idx, std::uint8_t val) {
+            std::atomic_ref byte(m_owned[idx >> 1]);
+            const int shift = (idx & 1) * 4;
+            std::uint8_t expected = byte.load(std::memory_order_relaxed);
+            do {
+                if (((expected >> shift) & 0xf) != unvisited)
+                { return false; }
+            } while (!byte.compare_exchange_weak(expected,
+                std::uint8_t((expected & ~(0xf << shift)) | (val << shift)), std::memory_order_relaxed));
+            return true;
+        }
+
+        std::size_t size() const { return m_size; }
+        std::size_t bytes() const { return m_data.size(); }
+        std::span<const std::uint8_t> raw() const { return m_data; }
+
+    private:
+        std::size_t m_size = 0;
+        std::vector<std::uint8_t> m_owned;
+        std::span<const std::uint8_t> m_data;
+    };
+
+    /**
+     * @brief options of generate_table().
+     */
+    struct generator_config {
+        /* 0: one per hardware-thread */
+        int threads = 0;
+        /* shown in the progress-log, nothing is logged without a name. */
+        const char* name = nullptr;
+    };
+
+    namespace detail {
+
+        /* one progress-line per bfs-level through the groubiks-log (log.c), if it is initialized. */
+        void log_table_level(const char* name, int depth, bool backward, std::size_t found,
+            std::size_t visited, std::size_t size, double seconds);
+        void log_table_done(const char* name, std::size_t size, std::size_t bytes, double seconds);
+        void log_table_file(const std::filesystem::path& path, const char* event);
+
+    }
+
+    /**
+     * @brief generates a distance-table by a breadth-first search from index 0.
+     * @details `expand(index, visit)` calls visit(neighbour) for all neighbours of an index
+     *          and stops early once visit() returns true. neighbours must be symmetric
+     *          (the move-set contains all inverses), which all face-turn-sets do.
+     *
+     *          every level is a parallel sweep over the whole index-range, split into chunks
+     *          that the threads take from a shared counter:
+     *          - forward: every index of the current depth marks its unvisited neighbours.
+     *          - backward: every unvisited index looks for a neighbour of the current depth.
+     *          the sweep switches to backward once the frontier outgrows the unvisited
+     *          indices, since the last levels would otherwise expand almost every index
+     *          only to find all neighbours already visited.
+     */
+    template<class Table, class Expand>
+    void generate_table(Table& table, const generator_config& config, Expand&& expand) {
+        using clock_type = std::chrono::steady_clock;
+        constexpr std::size_t chunk_size = 1 << 14;
+
+        const auto start = clock_type::now();
+        const std::size_t size = table.size();
+        const int num_threads = config.threads > 0 ? config.threads : int(std::max(1u, std::thread::hardware_concurrency()));
+
+        table.set_if_unvisited(0, 0);
+        std::size_t visited = 1;
+        std::size_t frontier = 1;
+        for (std::uint8_t depth = 0; visited < size && depth + 1 < Table::unvisited; ++depth) {
+            const auto level_start = clock_type::now();
+            const bool backward = frontier > size - visited;
+            std::atomic<std::size_t> next_chunk = 0;
+            std::atomic<std::size_t> found = 0;
+
+            run_workers(num_threads, [&](int) {
+                std::size_t local_found = 0;
+                for (std::size_t begin; (begin = next_chunk.fetch_add(chunk_size, std::memory_order_relaxed)) < size;) {
+                    const std::size_t end = std::min(begin + chunk_size, size);
+                    for (std::size_t i = begin; i < end; ++i) {
+                        if (!backward) {
+                            if (table.atomic_get(i) != depth)
+                            { continue; }
+                            expand(i, [&](std::size_t n) {
+                                local_found += table.set_if_unvisited(n, depth + 1);
+                                return false;
+                            });
+                        } else {
+                            if (table.atomic_get(i) != Table::unvisited)
+                            { continue; }
+                            bool hit = false;
+                            expand(i, [&](std::size_t n) { return hit = table.atomic_get(n) == depth; });
+                            if (hit && table.set_if_unvisited(i, depth + 1))
+                            { ++local_found; }
+                        }
+                    }
+                }
+                found.fetch_add(local_found, std::memory_order_relaxed);
+            });
+
+            frontier = found;
+            visited += frontier;
+            detail::log_table_level(config.name, depth + 1, backward, frontier, visited, size,
+                std::chrono::duration<double>(clock_type::now() - level_start).count());
+            if (frontier == 0)
+            { break; }
+        }
+        detail::log_table_done(config.name, size, table.bytes(),
+            std::chrono::duration<double>(clock_type::now() - start).count());
+    }
+
+    /**
+     * @brief byte-distance-table over `size` indices with the neighbours next(index, move).
+     */
+    template<class Next>
+    byte_table build_pruning_table(std::size_t size, int num_moves, Next&& next, const generator_config& config = {}) {
+        byte_table res(size);
+        generate_table(res, config, [&](std::size_t i, auto&& visit) {
+            for (int m = 0; m < num_moves; ++m) {
+                if (visit(next(i, m)))
+                { return; }
+            }
+        });
+        return res;
+    }
+
+    template<class Expand>
+    nibble_table build_nibble_table(std::size_t size, Expand&& expand, const generator_config& config = {}) {
+        nibble_table res(size);
+        generate_table(res, config, expand);
+        return res;
+    }
+
+    /**
+     * @name table_file-sections. map_table() points `table` into the mapped file
+     *       if the section exists and holds exactly `count` entries.
+     * @{
+     */
+    template<class T>
+    bool map_table(const table_file& file, std::string_view name, flat_table<T>& table, std::size_t count) {
+        const auto data = file.section(name);
+        if (!data || data->size() != count * sizeof(T))
+        { return false; }
+        /* sections are page-aligned, so the cast is properly aligned. */
+        table = flat_table<T>(std::span<const T>(reinterpret_cast<const T*>(data->data()), count));
+        return true;
+    }
+
+    /* `count` is the number of entries, coordinates times moves. */
+    template<class T, int NumMoves, table_layout Layout>
+    bool map_table(const table_file& file, std::string_view name, coord_move_table<T, NumMoves, Layout>& table, std::size_t count) {
+        flat_table<T> elements;
+        if (!map_table(file, name, elements, count))
+        { return false; }
+        table = coord_move_table<T, NumMoves, Layout>(coord::coord_t(count / NumMoves), std::move(elements));
+        return true;
+    }
+
+    inline bool map_table(const table_file& file, std::string_view name, byte_table& table, std::size_t count) {
+        const auto data = file.section(name);
+        if (!data || data->size() != count)
+        { return false; }
+        table = byte_table(*data);
+        return true;
+    }
+
+    inline bool map_table(const table_file& file, std::string_view name, nibble_table& table, std::size_t count) {
+        const auto data = file.section(name);
+        if (!data || data->size() != nibble_table::bytes_for(count))
+        { return false; }
+        table = nibble_table(*data, count);
+        return true;
+    }
+
+    template<class T>
+    bool add_table(table_file_writer& writer, std::string_view name, const flat_table<T>& table)
+    { return writer.add(name, as_table_bytes(table.elements())); }
+
+    template<class T, int NumMoves, table_layout Layout>
+    bool add_table(table_file_writer& writer, std::string_view name, const coord_move_table<T, NumMoves, Layout>& table)
+    { return add_table(writer, name, table.elements()); }
+
+    inline bool add_table(table_file_writer& writer, std::string_view name, const byte_table& table)
+    { return writer.add(name, table.raw()); }
+
+    inline bool add_table(table_file_writer& writer, std::string_view name, const nibble_table& table)
+    { return writer.add(name, table.raw()); }
+    /**
+     * @}
+     */
+
+    /**
+     * @brief generate-if-missing: maps all tables from the file at `path`, or generates
+     *        them and (re)writes the file if it is missing, outdated or corrupted.
+     * @details `Tables` provides for_each_table(fn), which calls fn(name, table, entries)
+     *          for every table, generate(), and a std::optional<table_file> file, which
+     *          keeps the mapping alive as long as the tables point into it.
+     *          a failed write only costs the next process another generation.
+     * @returns true if the tables were mapped from the file.
+     */
+    template<class Tables>
+    bool load_or_generate(Tables& tables, const std::filesystem::path& path, bool verify) {
+        if (std::optional<table_file> file = table_file::open(path, verify)) {
+            bool complete = true;
+            tables.for_each_table([&](std::string_view name, auto& table, std::size_t count)
+            { complete = complete && map_table(*file, name, table, count); });
+            if (complete) {
+                tables.file = std::move(file);
+                detail::log_table_file(path, "mapped");
+                return true;
+            }
+        }
+        tables.generate();
+        table_file_writer writer;
+        tables.for_each_table([&](std::string_view name, const auto& table, std::size_t)
+        { add_table(writer, name, table); });
+        detail::log_table_file(path, writer.write(path) ? "generated and written" : "generated, but could not be written");
+        return false;
+    }
+
+#ifdef BUILD_TESTS
+    int tables_test(std::ostream& os);
+#endif
+
+}
+
+#endif
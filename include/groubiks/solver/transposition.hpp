@@ -0,0 +1,185 @@
+#ifndef GROUBIKS_SOLVER_TRANSPOSITION_HPP
+#define GROUBIKS_SOLVER_TRANSPOSITION_HPP
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <ostream>
+#include <groubiks/cube.hpp>
+
+/**
+ * @file transposition.hpp
+ * @brief fixed-size, lock-free hash-table from cube-states to small search-results,
+ *        shared by any number of threads.
+ * @details the table is an array of buckets (one cache-line, two slots each), indexed by
+ *          cube::hash() and sized from a memory-budget. a slot holds the full cube (no false
+ *          hits) and a meta-word: a busy-bit, an occupied-bit, the entry (depth and value)
+ *          and a version counted up by every write.
+ *          - a writer claims a slot by a compare-and-swap that sets the busy-bit, issues a
+ *            release-fence, writes the cube and releases the slot with the new meta-word.
+ *            a slot that is busy is skipped, writers never wait for each other.
+ *          - a reader reads the meta-word, the cube and the meta-word again (seqlock):
+ *            an entry that was written meanwhile is treated as a miss.
+ *          the replacement-policy decides which slot of a full bucket gives way.
+ */
+
+namespace groubiks::solver {
+
+    class transposition_table {
+    public:
+        enum class replacement {
+            /* a full bucket only gives up its shallowest entry, and only for one at least as deep. */
+            depth_preferred,
+            /* a new entry always replaces the shallowest entry of a full bucket. */
+            always_replace
+        };
+
+        struct config {
+            std::size_t memory_bytes = std::size_t(64) << 20;
+            replacement policy = replacement::depth_preferred;
+        };
+
+        /* a stored result: `depth` ranks entries for replacement, `value` is up to the user. */
+        struct entry {
+            std::uint16_t value;
+            std::uint8_t depth;
+
+            friend constexpr bool operator==(const entry&, const entry&) = default;
+        };
+
+        /* counters since construction or the last clear(), all relaxed. */
+        struct statistics {
+            std::uint64_t probes = 0;
+            std::uint64_t hits = 0;
+            std::uint64_t stores = 0;
+            /* stores that evicted the entry of another cube */
+            std::uint64_t replacements = 0;
+            /* stores dropped by the policy or because the slot was busy */
+            std::uint64_t rejected = 0;
+
+            double hit_rate() const
+            { return probes > 0 ? double(hits) / double(probes) : 0.0; }
+        };
+
+        /* the largest power-of-two number of buckets within config.memory_bytes (at least one). */
+        explicit transposition_table(const config& cfg);
+
+        std::optional<entry> probe(const cube& c) const {
+            const bucket& b = m_buckets[c.hash() & m_mask];
+            m_counters.probes.fetch_add(1, std::memory_order_relaxed);
+            for (const slot& s : b.slots) {
+                const std::uint64_t meta = s.meta.load(std::memory_order_acquire);
+                if ((meta & (busy_bit | occupied_bit)) != occupied_bit)
+                { continue; }
+                const cube stored{ s.vertex_bits.load(std::memory_order_relaxed), s.edge_bits.load(std::memory_order_relaxed) };
+                std::atomic_thread_fence(std::memory_order_acquire);
+                if (stored != c || s.meta.load(std::memory_order_relaxed) != meta)
+                { continue; }
+                m_counters.hits.fetch_add(1, std::memory_order_relaxed);
+                return unpack(meta);
+            }
+            return std::nullopt;
+        }
+
+        /**
+         * @brief inserts or updates the entry of `c`, as far as the policy allows.
+         * @returns false if the entry was not stored.
+         */
+        bool store(const cube& c, entry e) {
+            bucket& b = m_buckets[c.hash() & m_mask];
+            m_counters.stores.fetch_add(1, std::memory_order_relaxed);
+
+            /* the slot of c itself (always updated), else a free one, else the shallowest. */
+            slot* target = nullptr;
+            std::uint64_t target_meta = 0;
+            bool same = false;
+            for (slot& s : b.slots) {
+                const std::uint64_t meta = s.meta.load(std::memory_order_acquire);
+                if ((meta & occupied_bit) == 0) {
+                    if (target == nullptr || (target_meta & occupied_bit) != 0)
+                    { target = &s; target_meta = meta; }
+                    continue;
+                }
+                if (s.vertex_bits.load(std::memory_order_relaxed) == c.vertex_bits &&
+                    s.edge_bits.load(std::memory_order_relaxed) == c.edge_bits)
+                { target = &s; target_meta = meta; same = true; break; }
+                if (target == nullptr || ((target_meta & occupied_bit) != 0 && depth_of(meta) < depth_of(target_meta)))
+                { target = &s; target_meta = meta; }
+            }
+            const bool occupied = (target_meta & occupied_bit) != 0;
+            if (occupied && !same && m_policy == replacement::depth_preferred && e.depth < depth_of(target_meta))
+            { return reject(); }
+
+            if ((target_meta & busy_bit) != 0 ||
+                !target->meta.compare_exchange_strong(target_meta, target_meta | busy_bit, std::memory_order_acq_rel))
+            { return reject(); }
+            /* orders the busy meta-word before the cube, pairs with the fence in probe(). */
+            std::atomic_thread_fence(std::memory_order_release);
+            target->vertex_bits.store(c.vertex_bits, std::memory_order_relaxed);
+            target->edge_bits.store(c.edge_bits, std::memory_order_relaxed);
+            target->meta.store(pack(e, version_of(target_meta) + 1), std::memory_order_release);
+            if (occupied && !same)
+            { m_counters.replacements.fetch_add(1, std::memory_order_relaxed); }
+            return true;
+        }
+
+        /* empties all slots and resets the counters. not safe while other threads use the table. */
+        void clear();
+
+        statistics stats() const;
+        std::size_t capacity() const { return (m_mask + 1) * slots_per_bucket; }
+        std::size_t bytes() const { return (m_mask + 1) * sizeof(bucket); }
+        replacement policy() const { return m_policy; }
+
+    private:
+        static constexpr int slots_per_bucket = 2;
+        static constexpr std::uint64_t busy_bit = 1;
+        static constexpr std::uint64_t occupied_bit = 2;
+
+        /* meta-word: bit 0 busy, bit 1 occupied, bits 8..15 depth, 16..31 value, 32..63 version. */
+        static constexpr std::uint64_t pack(entry e, std::uint64_t version)
+        { return occupied_bit | std::uint64_t(e.depth) << 8 | std::uint64_t(e.value) << 16 | version << 32; }
+        static constexpr entry unpack(std::uint64_t meta)
+        { return { std::uint16_t(meta >> 16), std::uint8_t(meta >> 8) }; }
+        static constexpr std::uint8_t depth_of(std::uint64_t meta)
+        { return std::uint8_t(meta >> 8); }
+        static constexpr std::uint64_t version_of(std::uint64_t meta)
+        { return meta >> 32; }
+
+        bool reject() {
+            m_counters.rejected.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+
+        struct slot {
+            std::atomic<std::uint64_t> meta = 0;
+            std::atomic<std::uint64_t> vertex_bits = 0;
+            std::atomic<std::uint64_t> edge_bits = 0;
+            std::uint64_t padding = 0;
+        };
+        struct alignas(64) bucket {
+            slot slots[slots_per_bucket];
+        };
+        static_assert(sizeof(bucket) == 64);
+
+        /* each counter on its own cache-line, so counting does not serialize the probes. */
+        struct alignas(64) counter : std::atomic<std::uint64_t> {};
+        struct counters {
+            counter probes, hits, stores, replacements, rejected;
+        };
+
+        std::unique_ptr<bucket[]> m_buckets;
+        std::size_t m_mask = 0;
+        replacement m_policy;
+        mutable counters m_counters;
+    };
+
+#ifdef BUILD_TESTS
+    int transposition_test(std::ostream& os);
+#endif
+
+}
+
+#endif
@@ -0,0 +1,97 @@
+
+#ifndef GROUBIKS_SOLVER_WORK_STEALING_HPP
+#define GROUBIKS_SOLVER_WORK_STEALING_HPP
+
+#include <atomic>
+#include <cstdint>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <thread>
+#include <vector>
+
+/**
+ * @file work_stealing.hpp
+ * @brief task-deques for a fixed set of worker-threads.
+ * @details every worker owns a deque. it takes its own tasks from the back (the most
+ *          recently pushed, i.e. the ones closest to what it just worked on) and, once its
+ *          deque runs empty, steals from the front of the other deques (the oldest tasks,
+ *          usually the largest subtrees). each deque has its own lock, so workers
+ *          only contend while stealing.
+ */
+
+namespace groubiks::solver {
+
+    template<class Task>
+    class work_stealing_queues {
+    public:
+        explicit work_stealing_queues(int num_workers)
+            : m_num_workers(num_workers), m_queues(std::make_unique<queue[]>(num_workers)) {}
+
+        int num_workers() const { return m_num_workers; }
+
+        void push(int worker, Task task) {
+            queue& q = m_queues[worker];
+            std::lock_guard lock(q.lock);
+            q.tasks.push_back(std::move(task));
+        }
+
+        /**
+         * @returns the next task of `worker`, a stolen task if its own deque is empty,
+         *          or nothing if all deques are empty.
+         */
+        std::optional<Task> pop(int worker) {
+            {
+                queue& q = m_queues[worker];
+                std::lock_guard lock(q.lock);
+                if (!q.tasks.empty()) {
+                    Task res = std::move(q.tasks.back());
+                    q.tasks.pop_back();
+                    return res;
+                }
+            }
+            for (int i = 1; i < m_num_workers; ++i) {
+                queue& q = m_queues[(worker + i) % m_num_workers];
+                std::lock_guard lock(q.lock);
+                if (!q.tasks.empty()) {
+                    Task res = std::move(q.tasks.front());
+                    q.tasks.pop_front();
+                    m_steals.fetch_add(1, std::memory_order_relaxed);
+                    return res;
+                }
+            }
+            return std::nullopt;
+        }
+
+        std::uint64_t steals() const
+        { return m_steals.load(std::memory_order_relaxed); }
+
+    private:
+        /* one cache-line per deque, so the locks of different workers do not share lines. */
+        struct alignas(64) queue {
+            std::mutex lock;
+            std::deque<Task> tasks;
+        };
+
+        int m_num_workers;
+        std::unique_ptr<queue[]> m_queues;
+        std::atomic<std::uint64_t> m_steals = 0;
+    };
+
+    /**
+     * @brief runs fn(worker) on `num_workers` threads (worker 0 on the calling thread)
+     *        and waits for all of them.
+     */
+    template<class Fn>
+    void run_workers(int num_workers, Fn&& fn) {
+        std::vector<std::jthread> threads;
+        threads.reserve(num_workers - 1);
+        for (int w = 1; w < num_workers; ++w)
+        { threads.emplace_back([&fn, w] { fn(w); }); }
+        fn(0);
+    }
+
+}
+
+#endif
@@ -59,12 +59,34 @@ clampui(unsigned int v,
     unsigned int hi
 );
 
+/**
+ * @brief reads a whole file into a malloc'ed buffer. fine for small files like shaders.
+ * @returns 0 on success, -1 on error.
+ */
 int 
 readFile(const char* path, 
     char** ptr, 
     size_t* size
 );
 
+/**
+ * @brief maps a whole file read-only into memory, for large assets.
+ *        nothing is copied, pages are loaded by the os on first access and shared
+ *        between all processes mapping the same file. free with unmapFile().
+ *        falls back to readFile() where mmap is not available.
+ * @returns 0 on success, -1 on error (also for empty files).
+ */
+int 
+mapFile(const char* path, 
+    const void** ptr, 
+    size_t* size
+);
+
+void 
+unmapFile(const void* ptr, 
+    size_t size
+);
+
 /**
  * @brief classic macro-overload counting-magic.
  */
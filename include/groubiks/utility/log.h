@@ -73,18 +73,8 @@ typedef struct {
     int m_use_timestamp;
 } log_t;
 
-dynarray_result_t copy_log(log_t* dest, const log_t* src) {
-    assert(dest && src);
-    dest->m_fno = src->m_fno;
-    dest->m_prefix = strdup(src->m_prefix);
-    dest->m_use_timestamp = src->m_use_timestamp;
-    return dest->m_prefix == NULL ? DYNARRAY_ERROR : DYNARRAY_SUCCESS;
-}
-
-void free_log(log_t* ptr) {
-    assert(ptr);
-    free(ptr->m_prefix);
-}
+dynarray_result_t copy_log(log_t* dest, const log_t* src);
+void free_log(log_t* ptr);
 
 declare_dynarray(log_t, log);
 /**
@@ -115,6 +105,11 @@ int log_init();
  * @brief print out all stored up logs to their designated streams and free resources.
  */
 void log_end();
+/**
+ * @returns 1 between log_init() and log_end(), 0 otherwise.
+ *          lets library-code log only if the application set up logging.
+ */
+int log_initialized();
 /**
  * @brief create a new log in the global log-container.
  * @returns index to the log in the container, or -1 on error.
@@ -0,0 +1,127 @@
+#ifndef GROUBIKS_BENCH_HPP
+#define GROUBIKS_BENCH_HPP
+
+/**
+ * @file bench.hpp
+ * @brief microbenchmarks of the groubiks_bench target.
+ * @details the suite (see suite.cpp) times small kernels with warm-up and repetitions and
+ *          reports their statistics as text and json, so runs of different versions can be
+ *          compared. the reports below are longer experiments that print their own findings.
+ */
+
+#include <chrono>
+#include <cstddef>
+#include <ostream>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace groubiks::bench {
+
+    using clock_type = std::chrono::steady_clock;
+
+    inline double seconds_since(clock_type::time_point start)
+    { return std::chrono::duration<double>(clock_type::now() - start).count(); }
+
+    /* keeps the compiler from dropping a computation whose result is otherwise unused. */
+    template<class T>
+    inline void do_not_optimize(const T& value)
+    { asm volatile("" : : "r,m"(value) : "memory"); }
+
+    struct options {
+        int warmup = 1;
+        int repetitions = 5;
+        /* only run benchmarks whose name contains this. */
+        std::string filter;
+    };
+
+    /* the timings of one benchmark, `items` units of work per repetition. */
+    struct result {
+        std::string name;
+        std::string unit;
+        double items = 0.0;
+        std::vector<double> seconds;
+
+        double min() const;
+        double median() const;
+        double mean() const;
+        double stddev() const;
+        /* items per second of the median repetition. */
+        double rate() const
+        { return items / median(); }
+    };
+
+    class suite {
+    public:
+        /* every result is printed to `progress` as soon as it is measured. */
+        suite(const options& opts, std::ostream& progress);
+
+        bool selected(std::string_view name) const
+        { return name.find(m_options.filter) != std::string_view::npos; }
+
+        /* runs fn(), which does `items` units of work, warmup + repetitions times. */
+        template<class Fn>
+        void run(std::string_view name, std::string_view unit, double items, Fn&& fn) {
+            if (!selected(name))
+            { return; }
+            for (int i = 0; i < m_options.warmup; ++i)
+            { fn(); }
+            result res{ std::string(name), std::string(unit), items, {} };
+            for (int i = 0; i < m_options.repetitions; ++i) {
+                const auto start = clock_type::now();
+                fn();
+                res.seconds.push_back(seconds_since(start));
+            }
+            m_results.push_back(std::move(res));
+            print(m_progress, m_results.back());
+        }
+
+        const std::vector<result>& results() const { return m_results; }
+
+        static void print(std::ostream& os, const result& res);
+        void write_json(std::ostream& os) const;
+
+    private:
+        options m_options;
+        std::ostream& m_progress;
+        std::vector<result> m_results;
+    };
+
+    /**
+     * @name the suite: moves, coordinates, table-lookups, utility-containers and logging,
+     *       and whole solves.
+     * @{
+     */
+    void cube_kernels(suite& s);
+    void table_lookups(suite& s);
+    void utility(suite& s);
+    void solves(suite& s);
+    /**
+     * @}
+     */
+
+    /**
+     * @name reports.
+     * @{
+     */
+    void moves(std::ostream& os);
+    void notation(std::ostream& os);
+    void move_automaton(std::ostream& os);
+    void random_states(std::ostream& os);
+    void nxn(std::ostream& os);
+    void batch(std::ostream& os);
+    void validation(std::ostream& os);
+    void facelets(std::ostream& os);
+    void symmetry_tables(std::ostream& os);
+    void parallel_search(std::ostream& os);
+    void transposition(std::ostream& os);
+    void external_search(std::ostream& os);
+    void short_solves(std::ostream& os);
+    void coordinate_search(std::ostream& os);
+    /**
+     * @}
+     */
+
+}
+
+#endif
@@ -0,0 +1,109 @@
+#include "bench.hpp"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+#include <groubiks/cube/batch.hpp>
+#include <groubiks/cube/facelets.hpp>
+#include <groubiks/cube/random.hpp>
+#include <groubiks/cube/simd.hpp>
+#include <groubiks/cube/validate.hpp>
+
+/**
+ * @brief the same 20-move sequence applied to 2^20 cubes,
+ *        once cube by cube and once through a cube_batch.
+ */
+void groubiks::bench::batch(std::ostream& os) {
+    constexpr std::size_t num_cubes = 1 << 20;
+    const move_t seq[] = { move_t::R, move_t::U, move_t::Rp, move_t::Up, move_t::F2, move_t::L,
+        move_t::Dp, move_t::B, move_t::R2, move_t::Fp, move_t::U2, move_t::Lp, move_t::D,
+        move_t::Bp, move_t::F, move_t::R, move_t::D2, move_t::L2, move_t::Up, move_t::B2 };
+    const double total = double(num_cubes) * std::size(seq);
+
+    std::vector<cube> cubes(num_cubes);
+    auto start = clock_type::now();
+    for (cube& c : cubes) {
+        for (move_t m : seq)
+        { apply_move(c, m); }
+    }
+    const double loop_secs = seconds_since(start);
+
+    start = clock_type::now();
+    for (cube& c : cubes)
+    { simd::apply_sequence(c, seq); }
+    const double simd_secs = seconds_since(start);
+
+    cube_batch b(num_cubes);
+    start = clock_type::now();
+    for (move_t m : seq)
+    { apply_move(b, m); }
+    const double batch_move_secs = seconds_since(start);
+
+    start = clock_type::now();
+    apply_sequence(b, seq);
+    const double batch_seq_secs = seconds_since(start);
+
+    const bool agree = b.get(num_cubes - 1) == cubes.back();
+    os << "batch of " << num_cubes << " cubes, " << std::size(seq) << " moves:\n"
+       << "  per-cube apply_move:      " << total / loop_secs / 1e6 << " M cube-moves/s\n"
+       << "  per-cube simd sequence:   " << total / simd_secs / 1e6 << " M cube-moves/s\n"
+       << "  cube_batch apply_move:    " << total / batch_move_secs / 1e6 << " M cube-moves/s\n"
+       << "  cube_batch apply_sequence: " << total / batch_seq_secs / 1e6 << " M cube-moves/s"
+       << (agree ? "" : " (results differ!)") << '\n';
+}
+
+/**
+ * @brief validate() over a batch of 2^20 random cubes with every kernel,
+ *        and cube by cube for comparison.
+ */
+void groubiks::bench::validation(std::ostream& os) {
+    constexpr std::size_t num_cubes = 1 << 20;
+    constexpr int num_passes = 16;
+    cube_batch b(num_cubes);
+    std::vector<cube> cubes(num_cubes);
+    xoshiro256 rng(100);
+    random_cubes(rng, cubes);
+    for (std::size_t k = 0; k < num_cubes; ++k)
+    { b.set(k, cubes[k]); }
+    std::vector<std::uint8_t> errors(num_cubes);
+
+    std::size_t invalid = 0;
+    auto start = clock_type::now();
+    for (const cube& c : cubes)
+    { invalid += validate(c) != 0; }
+    os << "validate single cubes:   " << double(num_cubes) / seconds_since(start) / 1e6 << " M cubes/s (" << invalid << " invalid)\n";
+
+    const simd::kernel_t detected = simd::active_kernel();
+    for (simd::kernel_t k : { simd::kernel_t::scalar, simd::kernel_t::avx2 }) {
+        if (!simd::select_kernel(k))
+        { continue; }
+        invalid = 0;
+        start = clock_type::now();
+        for (int pass = 0; pass < num_passes; ++pass)
+        { invalid += validate(b, errors); }
+        os << "validate batch " << simd::kernel_name(k) << ": " << std::string(8 - simd::kernel_name(k).size(), ' ')
+           << double(num_cubes) * num_passes / seconds_since(start) / 1e6 << " M cubes/s (" << invalid << " invalid)\n";
+    }
+    simd::select_kernel(detected);
+}
+
+/**
+ * @brief sticker-colors of 2^18 random cubes (what the renderer needs per frame) and back.
+ */
+void groubiks::bench::facelets(std::ostream& os) {
+    constexpr std::size_t num_cubes = 1 << 18;
+    std::vector<cube> cubes(num_cubes), read(num_cubes);
+    xoshiro256 rng(54);
+    random_cubes(rng, cubes);
+    std::vector<color_t> colors(num_cubes * num_facelets);
+
+    auto start = clock_type::now();
+    to_facelets(cubes, colors);
+    const double to_secs = seconds_since(start);
+    start = clock_type::now();
+    const std::size_t num_read = from_facelets(colors, read);
+    const double from_secs = seconds_since(start);
+    os << "to_facelets:   " << double(num_cubes) / to_secs / 1e6 << " M cubes/s\n"
+       << "from_facelets: " << double(num_cubes) / from_secs / 1e6 << " M cubes/s"
+       << (num_read == num_cubes && read == cubes ? "" : " (results differ!)") << '\n';
+}
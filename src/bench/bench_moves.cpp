@@ -0,0 +1,201 @@
+#include "bench.hpp"
+
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+#include <string>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/notation.hpp>
+#include <groubiks/cube/nxn.hpp>
+#include <groubiks/cube/random.hpp>
+#include <groubiks/cube/simd.hpp>
+
+/**
+ * @brief random sequence of face-turns, generated once so the timed loop only applies moves.
+ */
+static std::vector<groubiks::move_t> random_moves(std::size_t num) {
+    std::vector<groubiks::move_t> res(num);
+    std::uint64_t state = 0x2545f4914f6cdd1dull;
+    for (auto& m : res) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        m = groubiks::move_t(state % groubiks::num_moves);
+    }
+    return res;
+}
+
+void groubiks::bench::moves(std::ostream& os) {
+    constexpr std::size_t num_moves_per_pass = 1 << 16;
+    constexpr int num_passes = 512;
+
+    const std::vector<move_t> seq = random_moves(num_moves_per_pass);
+    cube c = cube::get_solved();
+
+    const auto start = clock_type::now();
+    for (int pass = 0; pass < num_passes; ++pass) {
+        apply_sequence(c, seq);
+    }
+    const double secs = seconds_since(start);
+    const double total = double(num_moves_per_pass) * num_passes;
+
+    os << "apply_move:     " << total / secs / 1e6 << " M moves/s"
+       << " (" << secs * 1e9 / total << " ns/move, hash " << c.hash() << ")\n";
+
+    const simd::kernel_t detected = simd::active_kernel();
+    for (simd::kernel_t k : { simd::kernel_t::scalar, simd::kernel_t::ssse3, simd::kernel_t::avx2 }) {
+        if (!simd::select_kernel(k))
+        { continue; }
+
+        c = cube::get_solved();
+        auto t = clock_type::now();
+        for (int pass = 0; pass < num_passes; ++pass) {
+            for (move_t m : seq)
+            { simd::apply_move(c, m); }
+        }
+        const double single_secs = seconds_since(t);
+        const std::size_t single_hash = c.hash();
+
+        c = cube::get_solved();
+        t = clock_type::now();
+        for (int pass = 0; pass < num_passes; ++pass)
+        { simd::apply_sequence(c, seq); }
+        const double seq_secs = seconds_since(t);
+
+        os << "simd " << simd::kernel_name(k) << ":\n"
+           << "  apply_move:     " << total / single_secs / 1e6 << " M moves/s (hash " << single_hash << ")\n"
+           << "  apply_sequence: " << total / seq_secs / 1e6 << " M moves/s (hash " << c.hash() << ")\n";
+    }
+    simd::select_kernel(detected);
+}
+
+/**
+ * @brief reading a long text of random moves in both notations, and canonicalizing it.
+ */
+void groubiks::bench::notation(std::ostream& os) {
+    const std::vector<move_t> seq = random_moves(1 << 20);
+    for (groubiks::notation n : { groubiks::notation::standard, groubiks::notation::lowercase_inverse }) {
+        const std::string text = format_moves(seq, n);
+        std::vector<move_t> parsed;
+        parsed.reserve(text.size());
+        const auto start = clock_type::now();
+        const bool ok = parse_moves(text, parsed, n);
+        const double secs = seconds_since(start);
+        os << "parse_moves (" << (n == groubiks::notation::standard ? "standard" : "lowercase-inverse") << "): "
+           << double(text.size()) / secs / (1 << 20) << " MB/s, " << double(parsed.size()) / secs / 1e6 << " M moves/s"
+           << (ok ? "" : " (failed)") << '\n';
+    }
+
+    std::vector<move_t> moves = seq;
+    const auto start = clock_type::now();
+    const std::size_t length = canonicalize(moves);
+    const double secs = seconds_since(start);
+    os << "canonicalize:   " << double(seq.size()) / secs / 1e6 << " M moves/s, "
+       << seq.size() << " -> " << length << " moves\n";
+}
+
+namespace {
+
+    /* a full search-tree of `togo` more moves below c, counting its nodes per depth. */
+    void expand(const groubiks::cube& c, int depth, int togo, int state,
+        const std::array<std::uint32_t, groubiks::num_sequence_states>& successors, std::uint64_t* nodes)
+    {
+        ++nodes[depth];
+        if (togo == 0)
+        { return; }
+        for (std::uint32_t moves = successors[state]; moves != 0; moves &= moves - 1) {
+            const auto m = groubiks::move_t(std::countr_zero(moves));
+            groubiks::cube next = c;
+            groubiks::apply_move(next, m);
+            expand(next, depth + 1, togo - 1, groubiks::next_sequence_state(m), successors, nodes);
+        }
+    }
+
+}
+
+/**
+ * @brief search-trees of depth 6 without any restriction, without turning the same face twice
+ *        (what the solvers used to do) and with the canonical move-automaton.
+ */
+void groubiks::bench::move_automaton(std::ostream& os) {
+    constexpr int depth = 6;
+    std::array<std::uint32_t, num_sequence_states> all{}, other_face{};
+    for (int state = 0; state < num_sequence_states; ++state) {
+        all[state] = (std::uint32_t(1) << num_moves) - 1;
+        other_face[state] = state < num_faces ? all[state] & ~(std::uint32_t(7) << (3 * state)) : all[state];
+    }
+    const std::pair<const char*, const std::array<std::uint32_t, num_sequence_states>*> rules[] = {
+        { "all moves:    ", &all }, { "other face:   ", &other_face }, { "automaton:    ", &successor_moves }
+    };
+    for (const auto& [name, successors] : rules) {
+        std::uint64_t nodes[depth + 1] = {};
+        const auto start = clock_type::now();
+        expand(cube::get_solved(), 0, depth, sequence_start, *successors, nodes);
+        const double secs = seconds_since(start);
+        std::uint64_t total = 0;
+        for (std::uint64_t n : nodes)
+        { total += n; }
+        os << "search-tree " << name << total << " nodes to depth " << depth << ", branching factor "
+           << double(nodes[depth]) / double(nodes[depth - 1]) << ", " << secs << " s\n";
+    }
+}
+
+/**
+ * @brief uniformly random states against 25-move random scrambles (the usual substitute),
+ *        both written into the same preallocated buffer.
+ */
+void groubiks::bench::random_states(std::ostream& os) {
+    constexpr int scramble_length = 25;
+    std::vector<cube> buffer(1 << 18);
+    xoshiro256 rng(42);
+
+    auto start = clock_type::now();
+    for (int pass = 0; pass < 8; ++pass)
+    { random_cubes(rng, buffer); }
+    double secs = seconds_since(start);
+    os << "random_cubes:   " << 8.0 * double(buffer.size()) / secs / 1e6 << " M states/s (hash " << buffer[7].hash() << ")\n";
+
+    start = clock_type::now();
+    for (cube& c : buffer) {
+        c = cube::get_solved();
+        for (int i = 0; i < scramble_length; ++i)
+        { apply_move(c, move_t(rng.below(num_moves))); }
+    }
+    secs = seconds_since(start);
+    os << "move-scrambles: " << double(buffer.size()) / secs / 1e6 << " M states/s (" << scramble_length
+       << " moves, hash " << buffer[7].hash() << ")\n";
+}
+
+namespace {
+
+    /* random layer-turns of all kinds on basic_cube<N>. */
+    template<int N>
+    void nxn_moves(std::ostream& os) {
+        using namespace groubiks;
+        constexpr int num_passes = 256;
+        std::vector<int> seq(1 << 16);
+        xoshiro256 rng(N);
+        for (int& m : seq)
+        { m = int(rng.below(basic_cube<N>::num_moves)); }
+
+        basic_cube<N> c = basic_cube<N>::get_solved();
+        const auto start = bench::clock_type::now();
+        for (int pass = 0; pass < num_passes; ++pass) {
+            for (int m : seq)
+            { apply_move(c, m); }
+        }
+        const double secs = bench::seconds_since(start);
+        os << "basic_cube<" << N << "> (" << sizeof(c) << " bytes, " << basic_cube<N>::num_moves << " moves): "
+           << double(seq.size()) * num_passes / secs / 1e6 << " M moves/s (solved " << c.is_solved() << ")\n";
+    }
+
+}
+
+/**
+ * @brief the unrolled layer-turn kernels for every size, cf. apply_move of the packed 3x3.
+ */
+void groubiks::bench::nxn(std::ostream& os) {
+    nxn_moves<2>(os);
+    nxn_moves<3>(os);
+    nxn_moves<4>(os);
+    nxn_moves<5>(os);
+}
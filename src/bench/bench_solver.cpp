@@ -0,0 +1,297 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <thread>
+#include <vector>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/solver/bidirectional.hpp>
+#include <groubiks/solver/external_bfs.hpp>
+#include <groubiks/solver/optimal.hpp>
+#include <groubiks/solver/tables.hpp>
+#include <groubiks/solver/transposition.hpp>
+#include <groubiks/solver/work_stealing.hpp>
+
+namespace {
+
+    std::vector<groubiks::cube> scrambles(int count, int length, std::uint64_t state) {
+        using namespace groubiks;
+        std::vector<cube> res(count);
+        for (cube& c : res) {
+            for (int i = 0, last_face = -1; i < length;) {
+                state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+                const int m = int(state % num_moves);
+                if (m / 3 == last_face)
+                { continue; }
+                apply_move(c, move_t(m));
+                last_face = m / 3;
+                ++i;
+            }
+        }
+        return res;
+    }
+
+}
+
+/**
+ * @brief the corner-table with and without the 16 U-D-symmetries: memory, generation-time
+ *        and the search-speed of a corner-only heuristic. both tables hold the same distances,
+ *        so both searches expand exactly the same nodes.
+ */
+void groubiks::bench::symmetry_tables(std::ostream& os) {
+    const std::vector<cube> cubes = scrambles(5, 11, 777);
+    for (bool symmetry : { false, true }) {
+        const auto start_tables = clock_type::now();
+        const solver::optimal engine(solver::pattern_config{ true, 0, 0, symmetry });
+        const double table_secs = seconds_since(start_tables);
+
+        std::uint64_t nodes = 0, lookups = 0;
+        const auto start = clock_type::now();
+        for (const cube& c : cubes) {
+            const solver::solution s = engine.solve(c, 20, std::chrono::minutes(10));
+            nodes += s.nodes;
+            lookups += s.lookups;
+        }
+        const double secs = seconds_since(start);
+        os << "corner-table " << (symmetry ? "by symmetry-class" : "full") << ": "
+           << double(engine.table_bytes()) / (1 << 20) << " MB, " << table_secs << " s to generate, "
+           << nodes << " nodes in " << secs << " s, " << double(lookups) / secs / 1e6 << " M lookups/s\n";
+    }
+}
+
+/**
+ * @brief the optimal solver on 12-move scrambles with 1, 2, 4, ... threads
+ *        up to the number of hardware-threads. efficiency is speedup / threads.
+ */
+void groubiks::bench::parallel_search(std::ostream& os) {
+    const auto start_tables = clock_type::now();
+    const solver::optimal engine(solver::pattern_config{ true, 5 });
+    os << "optimal solver, corners + 5-edge-groups (" << engine.table_bytes() / (1 << 20) << " MB), "
+       << seconds_since(start_tables) << " s to generate\n";
+
+    const std::vector<cube> cubes = scrambles(5, 12, 12345);
+
+    const int max_threads = int(std::max(1u, std::thread::hardware_concurrency()));
+    double single_secs = 0.0;
+    for (int threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+        std::uint64_t nodes = 0;
+        const auto start = clock_type::now();
+        for (const cube& c : cubes) {
+            const solver::solution s = engine.solve(c, 20, std::chrono::minutes(10), solver::parallel_config{ threads, 3 });
+            nodes += s.nodes;
+        }
+        const double secs = seconds_since(start);
+        if (threads == 1)
+        { single_secs = secs; }
+        os << "  " << threads << " threads: " << secs << " s, " << double(nodes) / secs / 1e6 << " M nodes/s, speedup "
+           << single_secs / secs << ", efficiency " << single_secs / secs / threads << '\n';
+        if (threads == max_threads)
+        { break; }
+    }
+}
+
+/**
+ * @brief probes and stores of the transposition-table with states of random walks,
+ *        under both replacement-policies, with 1, 2, 4, ... threads sharing one table.
+ *        the table holds a quarter of the states, so the hit-rate shows how the policy
+ *        keeps the deep entries (every state is stored with its step-number as depth).
+ */
+void groubiks::bench::transposition(std::ostream& os) {
+    using solver::transposition_table;
+    constexpr std::size_t num_states = 1 << 20;
+    constexpr int num_passes = 4;
+
+    std::vector<cube> states(num_states);
+    cube c = cube::get_solved();
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (cube& s : states) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        apply_move(c, move_t(state % num_moves));
+        s = c;
+    }
+
+    const int max_threads = int(std::max(1u, std::thread::hardware_concurrency()));
+    for (auto policy : { transposition_table::replacement::depth_preferred, transposition_table::replacement::always_replace }) {
+        os << "transposition_table, " << (policy == transposition_table::replacement::depth_preferred ? "depth_preferred" : "always_replace") << ":\n";
+        for (int threads = 1; ; threads = std::min(threads * 2, max_threads)) {
+            transposition_table table({ num_states / 4 * 32, policy });
+            const auto start = clock_type::now();
+            solver::run_workers(threads, [&](int w) {
+                for (int pass = 0; pass < num_passes; ++pass) {
+                    for (std::size_t i = w; i < num_states; i += threads) {
+                        if (!table.probe(states[i]))
+                        { table.store(states[i], { 0, std::uint8_t(i % 32) }); }
+                    }
+                }
+            });
+            const double secs = seconds_since(start);
+            const auto st = table.stats();
+            os << "  " << threads << " threads: " << double(st.probes + st.stores) / secs / 1e6 << " M operations/s, hit-rate "
+               << st.hit_rate() << ", " << st.replacements << " replacements, " << st.rejected << " rejected\n";
+            if (threads == max_threads)
+            { break; }
+        }
+    }
+}
+
+/**
+ * @brief the external breadth-first search over the 2x2 under <U, R, F> (3674160 states),
+ *        ranked sparsely as vertex-perm * 2187 + vertex-twist, with 32 MB for the sort-buffer.
+ *        the io-rate is the bytes of all levels and runs over the whole time, sorting included.
+ */
+void groubiks::bench::external_search(std::ostream& os) {
+    const std::array<move_t, 9> moves = { move_t::U, move_t::U2, move_t::Up, move_t::R, move_t::R2, move_t::Rp,
+        move_t::F, move_t::F2, move_t::Fp };
+    const auto perm_moves = solver::generate_move_table<std::uint16_t, 9>(coord::vertex_perm_coord, moves);
+    const auto twist_moves = solver::generate_move_table<std::uint16_t, 9>(coord::vertex_twist_coord, moves);
+
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "groubiks_bench_external_bfs";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    const solver::external_bfs_result res = solver::external_bfs({ dir, std::size_t(32) << 20 }).run(0,
+        [&](std::uint64_t rank, auto&& visit) {
+            const std::uint64_t perm = rank / coord::num_vertex_twists, twist = rank % coord::num_vertex_twists;
+            for (int m = 0; m < int(moves.size()); ++m)
+            { visit(std::uint64_t(perm_moves.next(coord::coord_t(perm), m)) * coord::num_vertex_twists + twist_moves.next(coord::coord_t(twist), m)); }
+        });
+    std::filesystem::remove_all(dir, ec);
+    os << "external bfs, 2x2 <U, R, F>:\n" << res;
+}
+
+namespace {
+
+    using groubiks::coord::coord_t;
+
+    /* distance-tables over two pairs of the phase-1-coordinates of the kociemba-solver, (slice, twist) and (slice, flip). */
+    struct phase1_bounds {
+        groubiks::solver::byte_table slice_twist;
+        groubiks::solver::byte_table slice_flip;
+
+        int get(coord_t twist, coord_t flip, coord_t slice) const {
+            using namespace groubiks;
+            return std::max(slice_twist.get(std::size_t(slice) * coord::num_vertex_twists + twist),
+                slice_flip.get(std::size_t(slice) * coord::num_edge_flips + flip));
+        }
+    };
+
+    /**
+     * @brief every phase-1-node within `togo` moves that the bounds cannot cut, on whole cubes:
+     *        each child is a moved cube, ranked into its three coordinates.
+     */
+    std::uint64_t cube_search(const phase1_bounds& bounds, const groubiks::cube& c, int togo, int state) {
+        using namespace groubiks;
+        std::uint64_t nodes = 1;
+        if (togo == 0)
+        { return nodes; }
+        for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+            const move_t m = move_t(std::countr_zero(moves));
+            cube child = c;
+            apply_move(child, m);
+            if (bounds.get(coord::vertex_twist(child), coord::edge_flip(child), coord::ud_slice(child)) < togo)
+            { nodes += cube_search(bounds, child, togo - 1, next_sequence_state(m)); }
+        }
+        return nodes;
+    }
+
+    /* the same search on the tuple (twist, flip, slice), moved through the move-tables. */
+    template<class Table>
+    std::uint64_t tuple_search(const phase1_bounds& bounds, const Table& twist_move, const Table& flip_move,
+        const Table& slice_move, coord_t twist, coord_t flip, coord_t slice, int togo, int state)
+    {
+        using namespace groubiks;
+        std::uint64_t nodes = 1;
+        if (togo == 0)
+        { return nodes; }
+        for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+            const int m = std::countr_zero(moves);
+            const coord_t t = twist_move.next(twist, m), f = flip_move.next(flip, m), s = slice_move.next(slice, m);
+            if (bounds.get(t, f, s) < togo)
+            { nodes += tuple_search(bounds, twist_move, flip_move, slice_move, t, f, s, togo - 1, next_sequence_state(move_t(m))); }
+        }
+        return nodes;
+    }
+
+}
+
+/**
+ * @brief the pruned phase-1-search of the kociemba-solver, three iterations beyond the first
+ *        solutions, on whole cubes against coordinate-tuples with both move-table-layouts.
+ *        all three expand exactly the same nodes.
+ */
+void groubiks::bench::coordinate_search(std::ostream& os) {
+    std::array<move_t, num_moves> all_moves{};
+    for (int m = 0; m < num_moves; ++m)
+    { all_moves[m] = move_t(m); }
+    using solver::table_layout;
+    const auto twist_by_coord = solver::generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves);
+    const auto flip_by_coord = solver::generate_move_table<std::uint16_t, num_moves>(coord::edge_flip_coord, all_moves);
+    const auto slice_by_coord = solver::generate_move_table<std::uint16_t, num_moves>(coord::ud_slice_coord, all_moves);
+    const auto twist_by_move = solver::generate_move_table<std::uint16_t, num_moves, table_layout::move_major>(coord::vertex_twist_coord, all_moves);
+    const auto flip_by_move = solver::generate_move_table<std::uint16_t, num_moves, table_layout::move_major>(coord::edge_flip_coord, all_moves);
+    const auto slice_by_move = solver::generate_move_table<std::uint16_t, num_moves, table_layout::move_major>(coord::ud_slice_coord, all_moves);
+    const phase1_bounds bounds{
+        solver::build_pruning_table(std::size_t(coord::num_ud_slices) * coord::num_vertex_twists, num_moves, [&](std::size_t i, int m) {
+            return std::size_t(slice_by_coord.next(coord_t(i / coord::num_vertex_twists), m)) * coord::num_vertex_twists
+                + twist_by_coord.next(coord_t(i % coord::num_vertex_twists), m);
+        }),
+        solver::build_pruning_table(std::size_t(coord::num_ud_slices) * coord::num_edge_flips, num_moves, [&](std::size_t i, int m) {
+            return std::size_t(slice_by_coord.next(coord_t(i / coord::num_edge_flips), m)) * coord::num_edge_flips
+                + flip_by_coord.next(coord_t(i % coord::num_edge_flips), m);
+        })
+    };
+
+    const std::vector<cube> cubes = scrambles(10, 30, 2323);
+    double cube_secs = 0.0;
+    for (int variant = 0; variant < 3; ++variant) {
+        std::uint64_t nodes = 0;
+        const auto start = clock_type::now();
+        for (const cube& c : cubes) {
+            const coord_t twist = coord::vertex_twist(c), flip = coord::edge_flip(c), slice = coord::ud_slice(c);
+            const int togo = bounds.get(twist, flip, slice) + 3;
+            if (variant == 0)
+            { nodes += cube_search(bounds, c, togo, sequence_start); }
+            else if (variant == 1)
+            { nodes += tuple_search(bounds, twist_by_coord, flip_by_coord, slice_by_coord, twist, flip, slice, togo, sequence_start); }
+            else
+            { nodes += tuple_search(bounds, twist_by_move, flip_by_move, slice_by_move, twist, flip, slice, togo, sequence_start); }
+        }
+        const double secs = seconds_since(start);
+        if (variant == 0)
+        { cube_secs = secs; }
+        os << "phase-1-search on " << (variant == 0 ? "whole cubes" : variant == 1 ? "coordinates, coord-major" : "coordinates, move-major")
+           << ": " << nodes << " nodes, " << double(nodes) / secs / 1e6 << " M nodes/s, speedup " << cube_secs / secs << '\n';
+    }
+}
+
+/**
+ * @brief the bidirectional solver against the optimal solver (single-threaded) on scrambles
+ *        of growing length: both find optimal solutions, the time per cube decides which one
+ *        to ask for states close to solved.
+ */
+void groubiks::bench::short_solves(std::ostream& os) {
+    const auto start_tables = clock_type::now();
+    const solver::bidirectional engine(5);
+    const double table_secs = seconds_since(start_tables);
+    const solver::optimal reference(solver::pattern_config{ true, 6, 0, true });
+    os << "bidirectional: " << engine.size() << " states within " << engine.depth() << " moves, "
+       << double(engine.table_bytes()) / (1 << 20) << " MB in " << table_secs << " s\n";
+
+    for (int length : { 6, 8, 10, 11, 12 }) {
+        const std::vector<cube> cubes = scrambles(length >= 11 ? 3 : 10, length, 4242 + length);
+        for (bool meet_in_the_middle : { true, false }) {
+            std::uint64_t moves = 0;
+            const auto start = clock_type::now();
+            for (const cube& c : cubes) {
+                const solver::solution s = meet_in_the_middle
+                    ? engine.solve(c, 20, std::chrono::minutes(10))
+                    : reference.solve(c, 20, std::chrono::minutes(10), solver::parallel_config{ 1 });
+                moves += s.moves.size();
+            }
+            const double secs = seconds_since(start);
+            os << length << "-move scrambles, " << (meet_in_the_middle ? "bidirectional" : "optimal") << ": "
+               << double(moves) / double(cubes.size()) << " moves, " << secs / double(cubes.size()) * 1e3 << " ms per cube\n";
+        }
+    }
+}
@@ -0,0 +1,255 @@
+#include "bench.hpp"
+
+#include <array>
+#include <cstdint>
+#include <cstdio>
+#include <vector>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/history.hpp>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/nxn.hpp>
+#include <groubiks/cube/random.hpp>
+#include <groubiks/cube/simd.hpp>
+#include <groubiks/solver/kociemba.hpp>
+#include <groubiks/solver/last_layer.hpp>
+#include <groubiks/solver/tables.hpp>
+
+/* after all other headers, log.h defines macros like log() and check(). */
+extern "C" {
+    #include <groubiks/utility/common.h>
+    #include <groubiks/utility/log.h>
+}
+
+namespace {
+
+    using namespace groubiks;
+
+    std::vector<move_t> random_moves(std::size_t num, std::uint64_t seed) {
+        std::vector<move_t> res(num);
+        xoshiro256 rng(seed);
+        for (move_t& m : res)
+        { m = move_t(rng.below(num_moves)); }
+        return res;
+    }
+
+    std::array<move_t, num_moves> all_moves() {
+        std::array<move_t, num_moves> res{};
+        for (int m = 0; m < num_moves; ++m)
+        { res[m] = move_t(m); }
+        return res;
+    }
+
+}
+
+void groubiks::bench::cube_kernels(suite& s) {
+    constexpr std::size_t num = 1 << 16;
+    const std::vector<move_t> seq = random_moves(num, 1);
+
+    s.run("apply_move/scalar", "moves", num, [&] {
+        cube c = cube::get_solved();
+        for (move_t m : seq)
+        { apply_move(c, m); }
+        do_not_optimize(c);
+    });
+    s.run("apply_move/simd", "moves", num, [&] {
+        cube c = cube::get_solved();
+        simd::apply_sequence(c, seq);
+        do_not_optimize(c);
+    });
+    s.run("apply_move/cube4", "moves", num, [&] {
+        cube4 c = cube4::get_solved();
+        apply_sequence(c, seq);
+        do_not_optimize(c);
+    });
+
+    std::vector<cube> cubes(4096);
+    xoshiro256 rng(2);
+    random_cubes(rng, cubes);
+    s.run("random_cube", "cubes", double(cubes.size()), [&] {
+        random_cubes(rng, cubes);
+        do_not_optimize(cubes.data());
+    });
+
+    /* ranks of all four coordinates of a cube, then the cube rebuilt from them. */
+    s.run("coord/rank", "cubes", double(cubes.size()), [&] {
+        coord::coord_t sum = 0;
+        for (const cube& c : cubes)
+        { sum += coord::vertex_twist(c) + coord::edge_flip(c) + coord::vertex_perm(c) + coord::edge_perm(c); }
+        do_not_optimize(sum);
+    });
+    std::vector<std::array<coord::coord_t, 4>> ranks(cubes.size());
+    for (std::size_t i = 0; i < cubes.size(); ++i)
+    { ranks[i] = { coord::vertex_twist(cubes[i]), coord::edge_flip(cubes[i]), coord::vertex_perm(cubes[i]), coord::edge_perm(cubes[i]) }; }
+    s.run("coord/unrank", "cubes", double(ranks.size()), [&] {
+        for (const auto& r : ranks) {
+            cube c{ 0, 0 };
+            coord::set_vertex_perm(c, r[2]);
+            coord::set_edge_perm(c, r[3]);
+            coord::set_vertex_twist(c, r[0]);
+            coord::set_edge_flip(c, r[1]);
+            do_not_optimize(c);
+        }
+    });
+
+    /* jumps to random points of a long replay, each costs at most half a chunk of moves. */
+    move_history history;
+    history.push(random_moves(1 << 17, 4));
+    std::vector<std::size_t> targets(1024);
+    for (std::size_t& t : targets)
+    { t = std::size_t(rng.below(history.size() + 1)); }
+    s.run("history/seek", "seeks", double(targets.size()), [&] {
+        for (std::size_t t : targets)
+        { history.seek(t); }
+        do_not_optimize(history.state());
+    });
+}
+
+/**
+ * @brief the lookups of a phase-1-like search: a random walk through the twist- and
+ *        flip-move-tables, reading the distance of every state from a twist x flip table.
+ *        the walk depends on every lookup, so this measures latency rather than throughput.
+ */
+void groubiks::bench::table_lookups(suite& s) {
+    if (!s.selected("tables/"))
+    { return; }
+    const auto moves = all_moves();
+    const auto twist_moves = solver::generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, moves);
+    const auto flip_moves = solver::generate_move_table<std::uint16_t, num_moves>(coord::edge_flip_coord, moves);
+    const auto twist_rows = solver::generate_move_table<std::uint16_t, num_moves, solver::table_layout::move_major>(
+        coord::vertex_twist_coord, moves);
+    const auto flip_rows = solver::generate_move_table<std::uint16_t, num_moves, solver::table_layout::move_major>(
+        coord::edge_flip_coord, moves);
+    const solver::byte_table distances = solver::build_pruning_table(std::size_t(coord::num_vertex_twists) * coord::num_edge_flips,
+        num_moves, [&](std::size_t i, int m) {
+            const coord::coord_t twist = coord::coord_t(i / coord::num_edge_flips), flip = coord::coord_t(i % coord::num_edge_flips);
+            return std::size_t(twist_moves.next(twist, m)) * coord::num_edge_flips + flip_moves.next(flip, m);
+        });
+
+    constexpr std::size_t num = 1 << 20;
+    const std::vector<move_t> walk = random_moves(num, 3);
+    s.run("tables/move", "lookups", 2.0 * num, [&] {
+        coord::coord_t twist = 0, flip = 0;
+        for (move_t m : walk) {
+            twist = twist_moves.next(twist, int(m));
+            flip = flip_moves.next(flip, int(m));
+        }
+        do_not_optimize(twist + flip);
+    });
+    s.run("tables/move/move-major", "lookups", 2.0 * num, [&] {
+        coord::coord_t twist = 0, flip = 0;
+        for (move_t m : walk) {
+            twist = twist_rows.next(twist, int(m));
+            flip = flip_rows.next(flip, int(m));
+        }
+        do_not_optimize(twist + flip);
+    });
+    s.run("tables/move+distance", "lookups", 3.0 * num, [&] {
+        coord::coord_t twist = 0, flip = 0;
+        std::size_t sum = 0;
+        for (move_t m : walk) {
+            twist = twist_moves.next(twist, int(m));
+            flip = flip_moves.next(flip, int(m));
+            sum += distances.get(std::size_t(twist) * coord::num_edge_flips + flip);
+        }
+        do_not_optimize(sum);
+    });
+
+    /* last layers scrambled by U-turns, Sune and the T-perm, each looked up with its two looks. */
+    solver::last_layer_db last_layer;
+    const move_t sune[] = { move_t::R, move_t::U, move_t::Rp, move_t::U, move_t::R, move_t::U2, move_t::Rp };
+    const move_t t_perm[] = { move_t::R, move_t::U, move_t::Rp, move_t::Up, move_t::Rp, move_t::F, move_t::R2,
+        move_t::Up, move_t::Rp, move_t::Up, move_t::R, move_t::U, move_t::Rp, move_t::Fp };
+    last_layer.add("Sune", sune);
+    last_layer.add("T-perm", t_perm);
+    std::vector<cube> last_layers(1 << 12, cube::get_solved());
+    for (std::size_t i = 0; i < last_layers.size(); ++i) {
+        for (move_t m : random_moves(6, i)) {
+            apply_move(last_layers[i], move_t::U);
+            apply_sequence(last_layers[i], std::uint8_t(m) % 2 ? std::span<const move_t>(sune) : std::span<const move_t>(t_perm));
+        }
+    }
+    s.run("tables/last_layer", "lookups", double(last_layers.size()), [&] {
+        std::size_t sum = 0;
+        for (const cube& c : last_layers) {
+            if (const auto match = last_layer.find(c))
+            { sum += std::size_t(match->pre_auf + match->post_auf) + match->solves; }
+        }
+        do_not_optimize(sum);
+    });
+}
+
+/**
+ * @brief the c-utilities used by the application: the u32-dynarray (appending, inserting
+ *        and erasing at the front, searching) and formatted logging to /dev/null.
+ */
+void groubiks::bench::utility(suite& s) {
+    constexpr u32 num = 1 << 16;
+    s.run("dynarray/push_back", "elements", num, [&] {
+        dynarray_result_t err = DYNARRAY_SUCCESS;
+        dynarray_t(u32) d = make_dynarray(u32, nullptr, 1, &err);
+        for (u32 i = 0; i < num; ++i)
+        { dynarray_push_back(u32, &d, i, &err); }
+        do_not_optimize(d.data[num / 2]);
+        free_dynarray(u32, &d);
+    });
+
+    /* insert/erase at the front move all elements, so fewer of them. */
+    constexpr u32 num_front = 1 << 12;
+    s.run("dynarray/insert_front+erase_front", "elements", num_front, [&] {
+        dynarray_result_t err = DYNARRAY_SUCCESS;
+        dynarray_t(u32) d = make_dynarray(u32, nullptr, 1, &err);
+        for (u32 i = 0; i < num_front; ++i)
+        { dynarray_insert(u32, &d, 0, i, &err); }
+        while (d.size > 0)
+        { dynarray_erase(u32, &d, 0, &err); }
+        free_dynarray(u32, &d);
+    });
+
+    std::vector<u32> values(num_front);
+    for (u32 i = 0; i < num_front; ++i)
+    { values[i] = i * 2654435761u; }
+    dynarray_result_t err = DYNARRAY_SUCCESS;
+    dynarray_t(u32) haystack = make_dynarray(u32, values.data(), values.size(), &err);
+    constexpr u32 num_finds = 256;
+    s.run("dynarray/find", "elements", double(num_finds) * num_front / 2, [&] {
+        for (u32 i = 0; i < num_finds; ++i)
+        { do_not_optimize(dynarray_find(u32, &haystack, values[(i * 97 + num_front / 2) % num_front])); }
+    });
+    free_dynarray(u32, &haystack);
+
+    if (!s.selected("log/"))
+    { return; }
+    const bool was_initialized = log_initialized();
+    if (!was_initialized && log_init() != 0)
+    { return; }
+    FILE* null_file = std::fopen("/dev/null", "w");
+    if (null_file != nullptr) {
+        log_redirect_all_to(null_file);
+        constexpr int num_messages = 1 << 14;
+        s.run("log/logf_info", "messages", num_messages, [&] {
+            for (int i = 0; i < num_messages; ++i)
+            { logf_info("depth %d, %zu nodes, %.3f s", i & 15, std::size_t(i) * 1000, double(i) * 1e-3); }
+        });
+        log_redirect_all_to(stderr);
+        std::fclose(null_file);
+    }
+    if (!was_initialized)
+    { log_end(); }
+}
+
+/**
+ * @brief end-to-end throughput of the two-phase solver on random cubes (tables are
+ *        generated before timing).
+ */
+void groubiks::bench::solves(suite& s) {
+    if (!s.selected("solve/"))
+    { return; }
+    const solver::kociemba engine;
+    std::vector<cube> cubes(16);
+    xoshiro256 rng(4);
+    random_cubes(rng, cubes);
+    s.run("solve/kociemba", "cubes", double(cubes.size()), [&] {
+        for (const cube& c : cubes)
+        { do_not_optimize(engine.solve(c, 22, std::chrono::seconds(10)).found); }
+    });
+}
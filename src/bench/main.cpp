@@ -0,0 +1,74 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <string_view>
+#include "bench.hpp"
+
+namespace {
+
+    void usage(std::ostream& os) {
+        os << "usage: groubiks_bench [options]\n"
+              "  --json <path>       write the results of the suite as json to <path>\n"
+              "  --repetitions <n>   timed repetitions of every benchmark (default 5)\n"
+              "  --warmup <n>        untimed runs before the repetitions (default 1)\n"
+              "  --filter <text>     only run benchmarks whose name contains <text>\n"
+              "  --no-reports        skip the reports after the suite\n";
+    }
+
+}
+
+int main(int argc, char** argv) {
+    groubiks::bench::options opts;
+    const char* json_path = nullptr;
+    bool reports = true;
+    for (int i = 1; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--json" && has_value)
+        { json_path = argv[++i]; }
+        else if (arg == "--repetitions" && has_value)
+        { opts.repetitions = std::atoi(argv[++i]); }
+        else if (arg == "--warmup" && has_value)
+        { opts.warmup = std::atoi(argv[++i]); }
+        else if (arg == "--filter" && has_value)
+        { opts.filter = argv[++i]; }
+        else if (arg == "--no-reports")
+        { reports = false; }
+        else {
+            usage(arg == "--help" ? std::cout : std::cerr);
+            return arg == "--help" ? 0 : 1;
+        }
+    }
+
+    groubiks::bench::suite s(opts, std::cout);
+    groubiks::bench::cube_kernels(s);
+    groubiks::bench::table_lookups(s);
+    groubiks::bench::utility(s);
+    groubiks::bench::solves(s);
+    if (json_path != nullptr) {
+        std::ofstream json(json_path);
+        s.write_json(json);
+        if (!json) {
+            std::cerr << "could not write " << json_path << "\n";
+            return 1;
+        }
+    }
+
+    if (!reports)
+    { return 0; }
+    groubiks::bench::moves(std::cout);
+    groubiks::bench::notation(std::cout);
+    groubiks::bench::move_automaton(std::cout);
+    groubiks::bench::random_states(std::cout);
+    groubiks::bench::nxn(std::cout);
+    groubiks::bench::batch(std::cout);
+    groubiks::bench::validation(std::cout);
+    groubiks::bench::facelets(std::cout);
+    groubiks::bench::symmetry_tables(std::cout);
+    groubiks::bench::parallel_search(std::cout);
+    groubiks::bench::transposition(std::cout);
+    groubiks::bench::external_search(std::cout);
+    groubiks::bench::short_solves(std::cout);
+    groubiks::bench::coordinate_search(std::cout);
+    return 0;
+}
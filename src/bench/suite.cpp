@@ -0,0 +1,92 @@
+#include "bench.hpp"
+
+#include <algorithm>
+#include <cmath>
+#include <ctime>
+#include <numeric>
+
+double groubiks::bench::result::min() const
+{ return *std::min_element(seconds.begin(), seconds.end()); }
+
+double groubiks::bench::result::median() const {
+    std::vector<double> sorted = seconds;
+    std::sort(sorted.begin(), sorted.end());
+    const std::size_t n = sorted.size();
+    return n % 2 ? sorted[n / 2] : (sorted[n / 2 - 1] + sorted[n / 2]) / 2.0;
+}
+
+double groubiks::bench::result::mean() const
+{ return std::accumulate(seconds.begin(), seconds.end(), 0.0) / double(seconds.size()); }
+
+double groubiks::bench::result::stddev() const {
+    if (seconds.size() < 2)
+    { return 0.0; }
+    const double m = mean();
+    double sum = 0.0;
+    for (double s : seconds)
+    { sum += (s - m) * (s - m); }
+    return std::sqrt(sum / double(seconds.size() - 1));
+}
+
+groubiks::bench::suite::suite(const options& opts, std::ostream& progress)
+    : m_options(opts), m_progress(progress)
+{
+    m_options.warmup = std::max(m_options.warmup, 0);
+    m_options.repetitions = std::max(m_options.repetitions, 1);
+}
+
+void groubiks::bench::suite::print(std::ostream& os, const result& res) {
+    const double rate = res.rate();
+    if (rate >= 1e6)
+    { os << res.name << ": " << rate / 1e6 << " M "; }
+    else if (rate >= 1e3)
+    { os << res.name << ": " << rate / 1e3 << " k "; }
+    else
+    { os << res.name << ": " << rate << " "; }
+    os << res.unit << "/s (median of "
+       << res.seconds.size() << ", min " << res.min() * 1e3 << " ms, mean " << res.mean() * 1e3
+       << " ms, stddev " << res.stddev() / res.mean() * 100.0 << " %)\n";
+}
+
+namespace {
+
+    /* names and units are plain identifiers, but quotes and backslashes would break the json. */
+    void write_string(std::ostream& os, std::string_view s) {
+        os << '"';
+        for (char ch : s) {
+            if (ch == '"' || ch == '\\')
+            { os << '\\'; }
+            os << ch;
+        }
+        os << '"';
+    }
+
+}
+
+void groubiks::bench::suite::write_json(std::ostream& os) const {
+    char timestamp[32] = {};
+    const std::time_t now = std::time(nullptr);
+    std::strftime(timestamp, sizeof(timestamp), "%Y-%m-%dT%H:%M:%SZ", std::gmtime(&now));
+
+    os << "{\n  \"context\": {\n";
+    os << "    \"date\": "; write_string(os, timestamp); os << ",\n";
+#ifdef __VERSION__
+    os << "    \"compiler\": "; write_string(os, __VERSION__); os << ",\n";
+#endif
+    os << "    \"warmup\": " << m_options.warmup << ",\n";
+    os << "    \"repetitions\": " << m_options.repetitions << "\n  },\n";
+    os << "  \"benchmarks\": [";
+    for (std::size_t i = 0; i < m_results.size(); ++i) {
+        const result& res = m_results[i];
+        os << (i ? ",\n" : "\n") << "    { \"name\": "; write_string(os, res.name);
+        os << ", \"unit\": "; write_string(os, res.unit);
+        os << ", \"items\": " << res.items
+           << ", \"min_s\": " << res.min() << ", \"median_s\": " << res.median()
+           << ", \"mean_s\": " << res.mean() << ", \"stddev_s\": " << res.stddev()
+           << ", \"items_per_second\": " << res.rate() << ", \"seconds\": [";
+        for (std::size_t k = 0; k < res.seconds.size(); ++k)
+        { os << (k ? ", " : "") << res.seconds[k]; }
+        os << "] }";
+    }
+    os << "\n  ]\n}\n";
+}
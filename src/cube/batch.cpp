@@ -0,0 +1,201 @@
+#include <groubiks/cube/batch.hpp>
+#include <groubiks/cube/simd.hpp>
+
+#include <cstring>
+
+#ifdef GROUBIKS_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+    using byte_type = groubiks::cube_batch::byte_type;
+
+    /**
+     * @brief orientation-kernels over one slot-array of `num` bytes (a multiple of 32).
+     *        twists: add `delta` (twist << 4) and subtract 0x30 where the twist reaches 3.
+     *        flips:  xor 0x10.
+     */
+    void add_twist_generic(byte_type* data, std::size_t num, byte_type delta) {
+        for (std::size_t i = 0; i < num; ++i) {
+            byte_type t = data[i] + delta;
+            data[i] = t - (t > 0x2f ? 0x30 : 0);
+        }
+    }
+
+    void flip_generic(byte_type* data, std::size_t num) {
+        for (std::size_t i = 0; i < num; ++i)
+        { data[i] ^= 0x10; }
+    }
+
+#ifdef GROUBIKS_SIMD_X86
+
+    __attribute__((target("avx2")))
+    void add_twist_avx2(byte_type* data, std::size_t num, byte_type delta) {
+        const __m256i d = _mm256_set1_epi8(static_cast<char>(delta));
+        const __m256i limit = _mm256_set1_epi8(0x2f);
+        const __m256i modulus = _mm256_set1_epi8(0x30);
+        for (std::size_t i = 0; i < num; i += 32) {
+            __m256i* p = reinterpret_cast<__m256i*>(data + i);
+            __m256i t = _mm256_add_epi8(_mm256_load_si256(p), d);
+            _mm256_store_si256(p, _mm256_sub_epi8(t, _mm256_and_si256(_mm256_cmpgt_epi8(t, limit), modulus)));
+        }
+    }
+
+    __attribute__((target("avx2")))
+    void flip_avx2(byte_type* data, std::size_t num) {
+        const __m256i bit = _mm256_set1_epi8(0x10);
+        for (std::size_t i = 0; i < num; i += 32) {
+            __m256i* p = reinterpret_cast<__m256i*>(data + i);
+            _mm256_store_si256(p, _mm256_xor_si256(_mm256_load_si256(p), bit));
+        }
+    }
+
+#endif
+
+    void add_twist(byte_type* data, std::size_t num, byte_type delta) {
+#ifdef GROUBIKS_SIMD_X86
+        if (groubiks::simd::active_kernel() == groubiks::simd::kernel_t::avx2)
+        { add_twist_avx2(data, num, delta); return; }
+#endif
+        add_twist_generic(data, num, delta);
+    }
+
+    void flip(byte_type* data, std::size_t num) {
+#ifdef GROUBIKS_SIMD_X86
+        if (groubiks::simd::active_kernel() == groubiks::simd::kernel_t::avx2)
+        { flip_avx2(data, num); return; }
+#endif
+        flip_generic(data, num);
+    }
+
+}
+
+groubiks::cube_batch::cube_batch(std::size_t size)
+    : m_size(size),
+      m_stride((size + alignment - 1) / alignment * alignment),
+      m_data(static_cast<byte_type*>(::operator new[](m_stride * num_slots, std::align_val_t(alignment))))
+{
+    for (int i = 0; i < cube::num_vertices; ++i) {
+        m_vertex_blocks[i] = i;
+        std::memset(vertex_slot(i), i, m_stride);
+    }
+    for (int i = 0; i < cube::num_edges; ++i) {
+        m_edge_blocks[i] = cube::num_vertices + i;
+        std::memset(edge_slot(i), i, m_stride);
+    }
+}
+
+groubiks::cube_batch::cube_batch(const cube_batch& other)
+    : cube_batch(other.m_size)
+{
+    *this = other;
+}
+
+groubiks::cube_batch& groubiks::cube_batch::operator=(const cube_batch& other) {
+    if (this == &other)
+    { return *this; }
+    if (m_stride != other.m_stride)
+    { *this = cube_batch(other.m_size); }
+    m_size = other.m_size;
+    std::memcpy(m_data.get(), other.m_data.get(), m_stride * num_slots);
+    m_vertex_blocks = other.m_vertex_blocks;
+    m_edge_blocks = other.m_edge_blocks;
+    return *this;
+}
+
+groubiks::cube groubiks::cube_batch::get(std::size_t idx) const {
+    cube res{ 0, 0 };
+    for (int i = 0; i < cube::num_vertices; ++i)
+    { res.vertex_bits |= cube::word_type(vertex_slot(i)[idx]) << (i * cube::vertex_field_bits); }
+    for (int i = 0; i < cube::num_edges; ++i)
+    { res.edge_bits |= cube::word_type(edge_slot(i)[idx]) << (i * cube::edge_field_bits); }
+    return res;
+}
+
+void groubiks::cube_batch::set(std::size_t idx, const cube& c) {
+    for (int i = 0; i < cube::num_vertices; ++i)
+    { vertex_slot(i)[idx] = byte_type(c.vertex_bits >> (i * cube::vertex_field_bits)); }
+    for (int i = 0; i < cube::num_edges; ++i)
+    { edge_slot(i)[idx] = byte_type((c.edge_bits >> (i * cube::edge_field_bits)) & cube::edge_field_mask); }
+}
+
+void groubiks::cube_batch::transform(const cube& t) {
+    const auto vertex_blocks = m_vertex_blocks;
+    const auto edge_blocks = m_edge_blocks;
+    for (int i = 0; i < cube::num_vertices; ++i) {
+        m_vertex_blocks[i] = vertex_blocks[t.vertex(i)];
+        if (const int twist = t.vertex_twist(i))
+        { add_twist(vertex_slot(i), m_stride, byte_type(twist << cube::orientation_shift)); }
+    }
+    for (int i = 0; i < cube::num_edges; ++i) {
+        m_edge_blocks[i] = edge_blocks[t.edge(i)];
+        if (t.edge_flip(i))
+        { flip(edge_slot(i), m_stride); }
+    }
+}
+
+void groubiks::apply_move(cube_batch& batch, move_t m)
+{ batch.transform(move_cubes[std::uint8_t(m)]); }
+
+void groubiks::apply_sequence(cube_batch& batch, std::span<const move_t> seq) {
+    cube t = cube::get_solved();
+    apply_sequence(t, seq);
+    batch.transform(t);
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file batch.cpp
+ * @brief batch.hpp unit-test.
+ */
+
+#include <vector>
+
+int groubiks::batch_test(std::ostream& os) {
+    constexpr std::size_t num = 1000;
+    std::uint64_t state = 0x853c49e6748fea9bull;
+    auto next_move = [&state]() {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        return move_t(state % num_moves);
+    };
+
+    /* fill the batch with differently scrambled cubes. */
+    cube_batch batch(num);
+    std::vector<cube> cubes(num);
+    for (std::size_t k = 0; k < num; ++k) {
+        for (std::size_t i = 0; i < k % 25; ++i)
+        { apply_move(cubes[k], next_move()); }
+        batch.set(k, cubes[k]);
+    }
+
+    std::vector<move_t> seq(40);
+    for (auto& m : seq)
+    { m = next_move(); }
+
+    const simd::kernel_t detected = simd::active_kernel();
+    for (simd::kernel_t k : { simd::kernel_t::scalar, simd::kernel_t::avx2 }) {
+        if (!simd::select_kernel(k))
+        { continue; }
+
+        cube_batch by_move = batch;
+        cube_batch by_sequence = batch;
+        for (move_t m : seq)
+        { apply_move(by_move, m); }
+        apply_sequence(by_sequence, seq);
+
+        for (std::size_t c = 0; c < num; ++c) {
+            cube expected = cubes[c];
+            apply_sequence(expected, seq);
+            if (by_move.get(c) != expected || by_sequence.get(c) != expected)
+            { os << "batch-cube " << c << " differs from the single cube\n"; return 1; }
+        }
+    }
+    simd::select_kernel(detected);
+
+    os << "batch_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,78 @@
+#include <groubiks/cube/coord.hpp>
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file coord.cpp
+ * @brief coord.hpp unit-test.
+ */
+
+#include <groubiks/cube/moves.hpp>
+
+namespace {
+
+    using namespace groubiks;
+
+    static_assert(coord::vertex_twist(cube::get_solved()) == 0);
+    static_assert(coord::edge_flip(cube::get_solved()) == 0);
+    static_assert(coord::vertex_perm(cube::get_solved()) == 0);
+    static_assert(coord::edge_perm(cube::get_solved()) == 0);
+    static_assert(coord::ud_slice(cube::get_solved()) == 0);
+    static_assert(coord::slice_perm(cube::get_solved()) == 0);
+
+    /* checks that unranking every value of a coordinate and ranking it again is the identity. */
+    template<class Rank, class Unrank>
+    bool round_trip(coord::coord_t count, Rank&& rank, Unrank&& unrank) {
+        for (coord::coord_t i = 0; i < count; ++i) {
+            cube c = cube::get_solved();
+            unrank(c, i);
+            if (rank(c) != i)
+            { return false; }
+        }
+        return true;
+    }
+
+}
+
+int groubiks::coord::coord_test(std::ostream& os) {
+    if (!round_trip(num_vertex_twists, vertex_twist, set_vertex_twist) ||
+        !round_trip(num_edge_flips, edge_flip, set_edge_flip) ||
+        !round_trip(num_vertex_perms, vertex_perm, set_vertex_perm) ||
+        !round_trip(num_ud_slices, ud_slice, set_ud_slice) ||
+        !round_trip(num_ud_edge_perms, ud_edge_perm, set_ud_edge_perm) ||
+        !round_trip(num_slice_perms, slice_perm, set_slice_perm) ||
+        !round_trip(num_edge_positions, edge_position_coord.rank, edge_position_coord.set))
+    { os << "a coordinate does not survive unranking and ranking\n"; return 1; }
+
+    /* edge_perm is too large to enumerate, sample it with a stride. */
+    if (!round_trip(num_edge_perms / 9973, [](const cube& c) { return edge_perm(c) / 9973; },
+        [](cube& c, coord_t i) { set_edge_perm(c, i * 9973); }))
+    { os << "edge_perm does not survive unranking and ranking\n"; return 1; }
+
+    /* the parity of a rank is the parity of the permutation it unranks into. */
+    for (coord_t i = 0; i < num_vertex_perms; i += 7) {
+        cube c = cube::get_solved();
+        set_vertex_perm(c, i);
+        set_edge_perm(c, i * 11879);
+        if (detail::rank_parity<cube::num_vertices>(i) != vertex_parity(c) ||
+            detail::rank_parity<cube::num_edges>(i * 11879) != edge_parity(c))
+        { os << "rank_parity differs from the parity of rank " << i << '\n'; return 1; }
+    }
+
+    /* a scrambled cube is fully described by its coordinates. */
+    cube c = cube::get_solved();
+    const move_t scramble[] = { move_t::R, move_t::U2, move_t::Fp, move_t::L, move_t::D2, move_t::Bp, move_t::R2 };
+    apply_sequence(c, scramble);
+    cube r = cube::get_solved();
+    set_vertex_perm(r, vertex_perm(c));
+    set_edge_perm(r, edge_perm(c));
+    set_vertex_twist(r, vertex_twist(c));
+    set_edge_flip(r, edge_flip(c));
+    if (r != c || vertex_parity(c) != edge_parity(c))
+    { os << "coordinates do not describe the scrambled cube\n"; return 1; }
+
+    os << "coord_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,57 @@
+#include <groubiks/cube.hpp>
+
+std::ostream& groubiks::operator<<(std::ostream& os, const groubiks::cube& c) {
+    os << "vertices: [ ";
+    for (int i = 0; i < cube::num_vertices; ++i) {
+        os << c.vertex(i) << '.' << c.vertex_twist(i) << ' ';
+    }
+    os << "] edges: [ ";
+    for (int i = 0; i < cube::num_edges; ++i) {
+        os << c.edge(i) << '.' << c.edge_flip(i) << ' ';
+    }
+    return os << ']';
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file cube.cpp
+ * @brief cube.hpp unit-test.
+ */
+
+int groubiks::cube_test(std::ostream& os) {
+    constexpr cube solved = cube::get_solved();
+    static_assert(solved.is_solved());
+    static_assert(solved.vertex(7) == 7 && solved.edge(11) == 11);
+    static_assert((solved.edge_bits >> 60) == 0);
+
+    /* every piece and orientation must survive a round-trip through the unpacked layout. */
+    cube::layout l{};
+    for (int i = 0; i < cube::num_vertices; ++i) {
+        l.vertices[i] = (i * 3 + 1) % cube::num_vertices;
+        l.vertex_twists[i] = i % 3;
+    }
+    for (int i = 0; i < cube::num_edges; ++i) {
+        l.edges[i] = (i * 5 + 2) % cube::num_edges;
+        l.edge_flips[i] = i % 2;
+    }
+    cube c = cube::pack(l);
+    os << c << '\n';
+
+    cube::layout r = c.unpack();
+    for (int i = 0; i < cube::num_vertices; ++i) {
+        if (r.vertices[i] != l.vertices[i] || r.vertex_twists[i] != l.vertex_twists[i])
+        { os << "vertex " << i << " did not survive packing\n"; return 1; }
+    }
+    for (int i = 0; i < cube::num_edges; ++i) {
+        if (r.edges[i] != l.edges[i] || r.edge_flips[i] != l.edge_flips[i])
+        { os << "edge " << i << " did not survive packing\n"; return 1; }
+    }
+    if (c == solved || c.hash() == solved.hash() || std::hash<cube>{}(c) != c.hash())
+    { os << "packed cubes compare or hash wrong\n"; return 1; }
+
+    os << "cube_test passed\n";
+    return 0;
+}
+
+#endif
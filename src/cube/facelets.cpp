@@ -0,0 +1,83 @@
+#include <groubiks/cube/facelets.hpp>
+
+void groubiks::to_facelets(std::span<const cube> cubes, std::span<color_t> out, const color_scheme& scheme) {
+    for (std::size_t k = 0; k < cubes.size(); ++k)
+    { to_facelets(cubes[k], out.subspan(k * num_facelets).first<num_facelets>(), scheme); }
+}
+
+std::size_t groubiks::from_facelets(std::span<const color_t> colors, std::span<cube> out) {
+    for (std::size_t k = 0; k < out.size(); ++k) {
+        const std::optional<cube> c = from_facelets(colors.subspan(k * num_facelets).first<num_facelets>());
+        if (!c)
+        { return k; }
+        out[k] = *c;
+    }
+    return out.size();
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file facelets.cpp
+ * @brief facelets.hpp unit-test.
+ */
+
+#include <algorithm>
+#include <string_view>
+#include <vector>
+#include <groubiks/cube/random.hpp>
+
+namespace {
+
+    using namespace groubiks;
+
+    /* a facelet-string of face-letters in the default scheme. */
+    constexpr facelet_colors from_letters(std::string_view letters) {
+        constexpr std::string_view faces = "URFDLB";
+        facelet_colors res{};
+        for (int i = 0; i < num_facelets; ++i)
+        { res[i] = default_scheme[faces.find(letters[i])]; }
+        return res;
+    }
+
+    static_assert(to_facelets(cube::get_solved()) ==
+        from_letters("UUUUUUUUURRRRRRRRRFFFFFFFFFDDDDDDDDDLLLLLLLLLBBBBBBBBB"));
+    static_assert(from_facelets(to_facelets(cube::get_solved())) == cube::get_solved());
+
+}
+
+int groubiks::facelets_test(std::ostream& os) {
+    /* the net after a clockwise R: F moves up, U moves back. */
+    if (to_facelets(move_cubes[int(move_t::R)]) !=
+        from_letters("UUFUUFUUFRRRRRRRRRFFDFFDFFDDDBDDBDDBLLLLLLLLLUBBUBBUBB"))
+    { os << "to_facelets() does not paint the stickers moved by R\n"; return 1; }
+
+    /* random cubes survive the round-trip, in any color-scheme. */
+    constexpr std::size_t num = 1000;
+    std::vector<cube> cubes(num), read(num);
+    xoshiro256 rng(17);
+    random_cubes(rng, cubes);
+    const color_scheme scheme = { RED, YELLOW, BLUE, ORANGE, WHITE, GREEN };
+    std::vector<color_t> colors(num * num_facelets);
+    to_facelets(cubes, colors, scheme);
+    if (from_facelets(colors, read) != num || read != cubes)
+    { os << "from_facelets() does not invert to_facelets()\n"; return 1; }
+
+    /* unreadable stickers. */
+    facelet_colors f = to_facelets(cubes[0]);
+    f[13] = f[4];
+    if (from_facelets(f))
+    { os << "from_facelets() accepted two centers of the same color\n"; return 1; }
+    f = to_facelets(cubes[0]);
+    f[detail::vertex_facelets[3][1]] = f[detail::vertex_facelets[3][0]];
+    if (from_facelets(f))
+    { os << "from_facelets() accepted a corner with two stickers of the same color\n"; return 1; }
+    std::copy(f.begin(), f.end(), colors.begin() + 5 * num_facelets);
+    if (from_facelets(colors, read) != 5)
+    { os << "from_facelets() of many cubes did not stop at the unreadable one\n"; return 1; }
+
+    os << "facelets_test passed\n";
+    return 0;
+}
+
+#endif
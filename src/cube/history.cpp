@@ -0,0 +1,196 @@
+#include <groubiks/cube/history.hpp>
+
+#include <algorithm>
+
+groubiks::move_history::move_history(const cube& start)
+{ clear(start); }
+
+void groubiks::move_history::clear(const cube& start) {
+    m_chunks.resize(1);
+    if (!m_chunks.front())
+    { m_chunks.front() = std::make_unique<chunk>(); }
+    m_chunks.front()->start = start;
+    m_size = m_position = 0;
+    m_state = start;
+}
+
+void groubiks::move_history::push(move_t m) {
+    if (m_position < m_size) {
+        m_size = m_position;
+        m_chunks.resize(std::max<std::size_t>(1, (m_size + chunk_moves - 1) / chunk_moves));
+    }
+    const std::size_t idx = m_position / chunk_moves;
+    if (idx == m_chunks.size())
+    { m_chunks.push_back(std::make_unique<chunk>(chunk{ m_state, {} })); }
+    m_chunks[idx]->moves[m_position % chunk_moves] = m;
+    apply_move(m_state, m);
+    m_size = ++m_position;
+}
+
+void groubiks::move_history::push(std::span<const move_t> seq) {
+    for (move_t m : seq)
+    { push(m); }
+}
+
+bool groubiks::move_history::undo() {
+    if (m_position == 0)
+    { return false; }
+    apply_move(m_state, inverse_move((*this)[--m_position]));
+    return true;
+}
+
+bool groubiks::move_history::redo() {
+    if (m_position == m_size)
+    { return false; }
+    apply_move(m_state, (*this)[m_position++]);
+    return true;
+}
+
+bool groubiks::move_history::seek(std::size_t pos) {
+    if (pos > m_size)
+    { return false; }
+    m_state = state_at(pos);
+    m_position = pos;
+    return true;
+}
+
+groubiks::cube groubiks::move_history::state_at(std::size_t pos) const {
+    const auto [from, c] = origin(pos);
+    return walk(c, from, pos);
+}
+
+std::size_t groubiks::move_history::jump_cost(std::size_t pos) const {
+    const std::size_t from = origin(pos).first;
+    return from > pos ? from - pos : pos - from;
+}
+
+std::pair<std::size_t, groubiks::cube> groubiks::move_history::origin(std::size_t pos) const {
+    /*
+     * the closest of the cursor, the checkpoint before `pos` and the one after it.
+     * the end of a log filling whole chunks has no checkpoint, the last one is before it.
+     */
+    const std::size_t before = std::min(pos / chunk_moves, m_chunks.size() - 1), after = pos / chunk_moves + 1;
+    const auto distance = [pos](std::size_t p) { return p > pos ? p - pos : pos - p; };
+    std::pair<std::size_t, cube> res{ m_position, m_state };
+    if (distance(before * chunk_moves) < distance(res.first))
+    { res = { before * chunk_moves, m_chunks[before]->start }; }
+    if (after < m_chunks.size() && distance(after * chunk_moves) < distance(res.first))
+    { res = { after * chunk_moves, m_chunks[after]->start }; }
+    return res;
+}
+
+groubiks::cube groubiks::move_history::walk(cube c, std::size_t from, std::size_t to) const {
+    for (; from < to; ++from)
+    { apply_move(c, (*this)[from]); }
+    for (; from > to; --from)
+    { apply_move(c, inverse_move((*this)[from - 1])); }
+    return c;
+}
+
+std::size_t groubiks::move_history::bytes() const
+{ return sizeof(*this) + m_chunks.capacity() * sizeof(m_chunks.front()) + m_chunks.size() * sizeof(chunk); }
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file history.cpp
+ * @brief history.hpp unit-test.
+ */
+
+#include <vector>
+#include <groubiks/cube/random.hpp>
+
+int groubiks::history_test(std::ostream& os) {
+    /* a replay of 100k random moves, and the cubes after every prefix of it. */
+    constexpr std::size_t num = 100000;
+    xoshiro256 rng(25);
+    std::vector<move_t> moves(num);
+    std::vector<cube> states(num + 1);
+    for (std::size_t i = 0; i < num; ++i) {
+        moves[i] = move_t(rng.below(num_moves));
+        states[i + 1] = states[i];
+        apply_move(states[i + 1], moves[i]);
+    }
+    move_history history;
+    history.push(moves);
+    if (history.size() != num || history.position() != num || history.state() != states[num])
+    { os << "pushing the replay did not reach its last state\n"; return 1; }
+    for (std::size_t i = 0; i < num; i += 997) {
+        if (history[i] != moves[i])
+        { os << "move " << i << " was not logged\n"; return 1; }
+    }
+    /* one byte per move, and one checkpoint per chunk. */
+    if (history.bytes() > num + (num / move_history::chunk_moves + 1) * 64 + 1024)
+    { os << "the log holds " << history.bytes() << " bytes for " << num << " moves\n"; return 1; }
+
+    /* jumps in both directions, from every kind of starting point. */
+    for (std::size_t pos : { std::size_t(0), std::size_t(1), move_history::chunk_moves - 1, move_history::chunk_moves,
+        std::size_t(54321), std::size_t(54322), num - 1, num, std::size_t(77777), std::size_t(3) }) {
+        if (history.state_at(pos) != states[pos])
+        { os << "state_at(" << pos << ") is not the state after " << pos << " moves\n"; return 1; }
+        if (!history.seek(pos) || history.position() != pos || history.state() != states[pos])
+        { os << "seek(" << pos << ") did not reach its state\n"; return 1; }
+    }
+    if (history.seek(num + 1) || history.position() != 3)
+    { os << "seek() went past the end of the log\n"; return 1; }
+    for (std::size_t i = 0; i < 2 * num; i += 3001) {
+        const std::size_t pos = std::size_t(rng.below(num + 1));
+        if (history.jump_cost(pos) > move_history::chunk_moves)
+        { os << "a jump to " << pos << " applies " << history.jump_cost(pos) << " moves\n"; return 1; }
+        if (!history.seek(pos) || history.state() != states[pos])
+        { os << "seek(" << pos << ") did not reach its state\n"; return 1; }
+    }
+
+    /* undo and redo around a chunk-boundary. */
+    history.seek(move_history::chunk_moves + 2);
+    for (std::size_t i = 0; i < 5; ++i) {
+        if (!history.undo() || history.state() != states[history.position()])
+        { os << "undo() did not restore the previous state\n"; return 1; }
+    }
+    for (std::size_t i = 0; i < 3; ++i) {
+        if (!history.redo() || history.state() != states[history.position()])
+        { os << "redo() did not restore the next state\n"; return 1; }
+    }
+    if (history.size() != num)
+    { os << "undo() and redo() changed the log\n"; return 1; }
+
+    /* a new move drops the undone ones, and then starts a chunk of its own. */
+    history.seek(2 * move_history::chunk_moves);
+    history.push(move_t::R);
+    cube expected = states[2 * move_history::chunk_moves];
+    apply_move(expected, move_t::R);
+    if (history.size() != 2 * move_history::chunk_moves + 1 || history.redo() || history.state() != expected ||
+        history.state_at(history.size() - 1) != states[2 * move_history::chunk_moves])
+    { os << "push() did not replace the undone moves\n"; return 1; }
+    while (history.undo())
+    {}
+    if (history.position() != 0 || history.state() != history.start() || history.undo())
+    { os << "undoing everything did not reach the start\n"; return 1; }
+
+    /* the end of a log filling whole chunks has no checkpoint of its own, the last one is used. */
+    history.clear();
+    history.push(std::span<const move_t>(moves).first(64 * move_history::chunk_moves));
+    if (!history.seek(0) || history.jump_cost(history.size()) != move_history::chunk_moves ||
+        history.jump_cost(history.size() - 1) != move_history::chunk_moves - 1)
+    { os << "a jump to the end of a log of whole chunks does not start at its last checkpoint\n"; return 1; }
+    history.clear();
+    history.push(std::span<const move_t>(moves).first(2 * move_history::chunk_moves));
+    if (!history.seek(0) || !history.seek(2 * move_history::chunk_moves) ||
+        history.state() != states[2 * move_history::chunk_moves] ||
+        history.state_at(2 * move_history::chunk_moves - 1) != states[2 * move_history::chunk_moves - 1])
+    { os << "seek() did not reach the end of a log of whole chunks\n"; return 1; }
+
+    /* a log from a scrambled cube. */
+    history.clear(states[num]);
+    history.push(move_t::U);
+    expected = states[num];
+    apply_move(expected, move_t::U);
+    if (history.size() != 1 || history.start() != states[num] || history.state() != expected ||
+        history.state_at(0) != states[num])
+    { os << "clear() did not restart the log\n"; return 1; }
+
+    os << "history_test passed\n";
+    return 0;
+}
+
+#endif
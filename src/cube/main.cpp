@@ -0,0 +1,30 @@
+#include <iostream>
+#include <groubiks/cube.hpp>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/simd.hpp>
+#include <groubiks/cube/batch.hpp>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/symmetry.hpp>
+#include <groubiks/cube/notation.hpp>
+#include <groubiks/cube/random.hpp>
+#include <groubiks/cube/validate.hpp>
+#include <groubiks/cube/facelets.hpp>
+#include <groubiks/cube/nxn.hpp>
+#include <groubiks/cube/history.hpp>
+
+#ifdef BUILD_TESTS
+int main(int argc, char** argv) {
+    return groubiks::cube_test(std::cout) ||
+        groubiks::moves_test(std::cout) ||
+        groubiks::simd::simd_test(std::cout) ||
+        groubiks::batch_test(std::cout) ||
+        groubiks::coord::coord_test(std::cout) ||
+        groubiks::symmetry_test(std::cout) ||
+        groubiks::notation_test(std::cout) ||
+        groubiks::random_test(std::cout) ||
+        groubiks::validate_test(std::cout) ||
+        groubiks::facelets_test(std::cout) ||
+        groubiks::nxn_test(std::cout) ||
+        groubiks::history_test(std::cout);
+}
+#endif
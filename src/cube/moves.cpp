@@ -0,0 +1,58 @@
+#include <groubiks/cube/moves.hpp>
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file moves.cpp
+ * @brief moves.hpp unit-test.
+ */
+
+namespace {
+
+    using namespace groubiks;
+
+    constexpr cube power_of(const cube& c, int n) {
+        cube res = cube::get_solved();
+        for (int i = 0; i < n; ++i)
+        { res = multiply(res, c); }
+        return res;
+    }
+
+    /* every quarter-turn has order 4, the sexy-move (R U R' U') has order 6. */
+    static_assert(power_of(move_cubes[int(move_t::R)], 4).is_solved());
+    static_assert(!power_of(move_cubes[int(move_t::F)], 2).is_solved());
+    static_assert(power_of(multiply(multiply(move_cubes[int(move_t::R)], move_cubes[int(move_t::U)]),
+        multiply(move_cubes[int(move_t::Rp)], move_cubes[int(move_t::Up)])), 6).is_solved());
+
+}
+
+int groubiks::moves_test(std::ostream& os) {
+    for (int m = 0; m < num_moves; ++m) {
+        const move_t mv = move_t(m);
+        cube c = cube::get_solved();
+        apply_move(c, mv);
+        if (c != move_cubes[m])
+        { os << "applying " << move_names[m] << " to a solved cube is wrong\n"; return 1; }
+        apply_move(c, inverse_move(mv));
+        if (!c.is_solved())
+        { os << move_names[m] << " is not undone by its inverse\n"; return 1; }
+    }
+
+    /* a scrambled cube is restored by the inverse sequence and by its inverse cube. */
+    const move_t scramble[] = { move_t::R, move_t::U2, move_t::Fp, move_t::L, move_t::D2,
+        move_t::Bp, move_t::R2, move_t::F, move_t::Up, move_t::L2, move_t::B, move_t::Dp };
+    cube c = cube::get_solved();
+    apply_sequence(c, scramble);
+    os << c << '\n';
+    if (multiply(c, inverse(c)) != cube::get_solved() || multiply(inverse(c), c) != cube::get_solved())
+    { os << "inverse(c) does not undo c\n"; return 1; }
+    for (int i = std::size(scramble) - 1; i >= 0; --i)
+    { apply_move(c, inverse_move(scramble[i])); }
+    if (!c.is_solved())
+    { os << "inverse scramble does not restore the cube\n"; return 1; }
+
+    os << "moves_test passed\n";
+    return 0;
+}
+
+#endif
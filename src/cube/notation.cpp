@@ -0,0 +1,381 @@
+#include <groubiks/cube/notation.hpp>
+
+#include <array>
+#include <cstdint>
+
+namespace {
+
+    using namespace groubiks;
+
+    /* what a character starts in the standard notation. */
+    enum class token : std::uint8_t {
+        invalid, space, face, wide, slice, rotation
+    };
+
+    struct token_info {
+        token kind = token::invalid;
+        /* the face that is turned (face), kept (wide) or followed (slice), or the axis of a rotation. */
+        face_t face = face_t::U;
+    };
+
+    constexpr std::array<token_info, 256> standard_tokens = [] {
+        std::array<token_info, 256> res{};
+        for (char c : { ' ', '\t', '\n', '\r', '\v', '\f' })
+        { res[std::uint8_t(c)] = { token::space }; }
+        constexpr char faces[] = "URFDLB";
+        constexpr char wides[] = "urfdlb";
+        for (int f = 0; f < num_faces; ++f) {
+            res[std::uint8_t(faces[f])] = { token::face, face_t(f) };
+            res[std::uint8_t(wides[f])] = { token::wide, face_t(f) };
+        }
+        res['M'] = { token::slice, face_t::L };
+        res['E'] = { token::slice, face_t::D };
+        res['S'] = { token::slice, face_t::F };
+        res['x'] = { token::rotation, face_t::R };
+        res['y'] = { token::rotation, face_t::U };
+        res['z'] = { token::rotation, face_t::F };
+        return res;
+    }();
+
+    /* the quarter-turn of the whole cube around U, R or F: the face at cycle[i] moves to cycle[i + 1]. */
+    constexpr face_t rotation_cycles[3][4] = {
+        { face_t::F, face_t::L, face_t::B, face_t::R },
+        { face_t::U, face_t::B, face_t::D, face_t::F },
+        { face_t::U, face_t::R, face_t::D, face_t::L }
+    };
+
+    /**
+     * @brief frame[f] is the (fixed) face that currently sits where face f is expected,
+     *        i.e. the face a turn of f written after some rotations really turns.
+     */
+    using frame_t = std::array<face_t, num_faces>;
+
+    constexpr frame_t identity_frame = { face_t::U, face_t::R, face_t::F, face_t::D, face_t::L, face_t::B };
+
+    /* rotates the whole cube by `power` clockwise quarter-turns around face `axis`. */
+    constexpr void rotate(frame_t& frame, face_t axis, int power) {
+        int a = std::uint8_t(axis);
+        if (a >= 3) {
+            a -= 3;
+            power = 4 - power;
+        }
+        const face_t (&cycle)[4] = rotation_cycles[a];
+        for (int p = 0; p < power % 4; ++p) {
+            const face_t last = frame[std::uint8_t(cycle[3])];
+            for (int i = 3; i > 0; --i)
+            { frame[std::uint8_t(cycle[i])] = frame[std::uint8_t(cycle[i - 1])]; }
+            frame[std::uint8_t(cycle[0])] = last;
+        }
+    }
+
+    /* the prime-character ', also as the typographic apostrophe U+2019 (e2 80 99 in utf-8). */
+    constexpr std::size_t prime_length(std::string_view text, std::size_t i) {
+        if (i < text.size() && text[i] == '\'')
+        { return 1; }
+        if (text.substr(i, 3) == "\xe2\x80\x99")
+        { return 3; }
+        return 0;
+    }
+
+    bool parse_standard(std::string_view text, std::vector<move_t>& out, std::size_t* error_offset) {
+        frame_t frame = identity_frame;
+        auto turn = [&](face_t f, int power) {
+            if (power % 4 != 0)
+            { out.push_back(make_move(frame[std::uint8_t(f)], power % 4)); }
+        };
+
+        std::size_t i = 0;
+        while (i < text.size()) {
+            const std::size_t start = i;
+            token_info t = standard_tokens[std::uint8_t(text[i++])];
+            if (t.kind == token::space)
+            { continue; }
+            if (t.kind == token::face && i < text.size() && text[i] == 'w') {
+                t.kind = token::wide;
+                ++i;
+            }
+            if (t.kind == token::invalid) {
+                if (error_offset != nullptr)
+                { *error_offset = start; }
+                return false;
+            }
+
+            /* suffix: a count with a prime before or after it (R2', R'2). */
+            std::size_t prime = prime_length(text, i);
+            i += prime;
+            int count = 0;
+            bool has_count = false;
+            for (; i < text.size() && text[i] >= '0' && text[i] <= '9'; ++i) {
+                count = (count * 10 + (text[i] - '0')) % 4;
+                has_count = true;
+            }
+            if (prime == 0) {
+                prime = prime_length(text, i);
+                i += prime;
+            }
+            int power = has_count ? count : 1;
+            if (prime != 0)
+            { power = (4 - power) % 4; }
+
+            const face_t f = t.face;
+            switch (t.kind) {
+                case token::face:
+                    turn(f, power);
+                    break;
+                case token::wide:
+                    turn(opposite_face(f), power);
+                    rotate(frame, f, power);
+                    break;
+                case token::slice:
+                    /* the slice follows face f: the whole cube turns with it, the outer layers turn back. */
+                    turn(opposite_face(f), power);
+                    turn(f, 4 - power);
+                    rotate(frame, f, power);
+                    break;
+                case token::rotation:
+                    rotate(frame, f, power);
+                    break;
+                default:
+                    break;
+            }
+        }
+        return true;
+    }
+
+    bool parse_lowercase_inverse(std::string_view text, std::vector<move_t>& out, std::size_t* error_offset) {
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const token_info t = standard_tokens[std::uint8_t(text[i])];
+            if (t.kind == token::face)
+            { out.push_back(make_move(t.face, 1)); }
+            else if (t.kind == token::wide)
+            { out.push_back(make_move(t.face, 3)); }
+            else if (t.kind != token::space) {
+                if (error_offset != nullptr)
+                { *error_offset = i; }
+                return false;
+            }
+        }
+        return true;
+    }
+
+    constexpr int face_of(move_t m)
+    { return std::uint8_t(m) / 3; }
+
+    constexpr bool opposite(int a, int b)
+    { return a % 3 == b % 3 && a != b; }
+
+}
+
+bool groubiks::parse_moves(std::string_view text, std::vector<move_t>& out, notation n, std::size_t* error_offset) {
+    if (n == notation::lowercase_inverse)
+    { return parse_lowercase_inverse(text, out, error_offset); }
+    return parse_standard(text, out, error_offset);
+}
+
+std::optional<std::vector<groubiks::move_t>> groubiks::parse_moves(std::string_view text, notation n) {
+    std::vector<move_t> res;
+    res.reserve(text.size());
+    if (!parse_moves(text, res, n))
+    { return std::nullopt; }
+    return res;
+}
+
+std::string groubiks::format_moves(std::span<const move_t> moves, notation n) {
+    constexpr char faces[] = "URFDLB";
+    constexpr char inverse_faces[] = "urfdlb";
+    std::string res;
+    res.reserve(moves.size() * 3);
+    for (move_t m : moves) {
+        const int f = face_of(m);
+        const int power = move_power(m);
+        if (n == notation::lowercase_inverse) {
+            if (power == 3)
+            { res += inverse_faces[f]; }
+            else
+            { res.append(std::size_t(power), faces[f]); }
+            continue;
+        }
+        if (!res.empty())
+        { res += ' '; }
+        res += move_names[std::uint8_t(m)];
+    }
+    return res;
+}
+
+std::size_t groubiks::canonicalize(std::vector<move_t>& moves) {
+    /* moves[0..top) is the canonical prefix, used as a stack. */
+    std::size_t top = 0;
+    auto merge = [&](std::size_t at, move_t m) {
+        const int power = (move_power(moves[at]) + move_power(m)) % 4;
+        if (power != 0) {
+            moves[at] = make_move(move_face(m), power);
+            return;
+        }
+        /* cancelled: drop the entry, a turn of the opposite face above it moves down. */
+        for (std::size_t i = at; i + 1 < top; ++i)
+        { moves[i] = moves[i + 1]; }
+        --top;
+    };
+
+    for (std::size_t i = 0; i < moves.size(); ++i) {
+        const move_t m = moves[i];
+        const int f = face_of(m);
+        if (top > 0 && face_of(moves[top - 1]) == f)
+        { merge(top - 1, m); }
+        else if (top > 1 && opposite(face_of(moves[top - 1]), f) && face_of(moves[top - 2]) == f)
+        { merge(top - 2, m); }
+        else {
+            moves[top++] = m;
+            if (top > 1 && opposite(face_of(moves[top - 2]), f) && face_of(moves[top - 2]) > f)
+            { std::swap(moves[top - 2], moves[top - 1]); }
+        }
+    }
+    moves.resize(top);
+    return top;
+}
+
+bool groubiks::is_canonical(std::span<const move_t> moves) {
+    for (std::size_t i = 1; i < moves.size(); ++i) {
+        const int f = face_of(moves[i]), prev = face_of(moves[i - 1]);
+        if (f == prev)
+        { return false; }
+        if (opposite(f, prev) && (prev > f || (i > 1 && face_of(moves[i - 2]) == f)))
+        { return false; }
+    }
+    return true;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file notation.cpp
+ * @brief notation.hpp unit-test.
+ */
+
+namespace {
+
+    cube apply_all(std::span<const move_t> moves) {
+        cube c = cube::get_solved();
+        apply_sequence(c, moves);
+        return c;
+    }
+
+}
+
+int groubiks::notation_test(std::ostream& os) {
+    struct example {
+        std::string_view text;
+        std::string_view expected;
+    };
+    /* wide, slice and rotated moves in terms of the 18 face-turns. */
+    const example standard_examples[] = {
+        { "R U2 F' D3 L1 B4", "R U2 F' D' L" },
+        { "R2' U'2 F\xe2\x80\x99", "R2 U2 F'" },
+        { "x U", "F" },
+        { "y R", "B" },
+        { "z U", "L" },
+        { "x y x' U R F", "z U R F" },
+        { "r U Rw' U", "L F L' U" },
+        { "M U M' U", "R L' B R' L U" },
+        { "E", "U D'" },
+        { "S2", "B2 F2" }
+    };
+    for (const example& e : standard_examples) {
+        const auto parsed = parse_moves(e.text);
+        const auto expected = parse_moves(e.expected);
+        if (!parsed || !expected || *parsed != *expected)
+        { os << "\"" << e.text << "\" is not read as \"" << e.expected << "\"\n"; return 1; }
+    }
+    /* a wide move is the face and the slice next to it. */
+    if (apply_all(*parse_moves("Rw U Fw' D")) != apply_all(*parse_moves("R M' U F' S' D")))
+    { os << "wide moves differ from face- and slice-moves\n"; return 1; }
+    /* the U-perm of slice-moves cycles three edges of the U-layer and nothing else. */
+    const cube u_perm = apply_all(*parse_moves("M2 U M U2 M' U M2"));
+    int moved_edges = 0;
+    for (int e = 0; e < cube::num_edges; ++e)
+    { moved_edges += u_perm.edge(e) != e; }
+    if (u_perm.vertex_bits != cube::solved_vertex_bits() || moved_edges != 3 || u_perm.edge(4) != 4)
+    { os << "the slice-moves of the U-perm are wrong: " << u_perm << '\n'; return 1; }
+
+    if (format_moves(*parse_moves("R U2 F' D L B")) != "R U2 F' D L B")
+    { os << "formatted moves differ from the parsed text\n"; return 1; }
+
+    std::size_t offset = 0;
+    std::vector<move_t> out;
+    if (parse_moves("R U Q F", out, notation::standard, &offset) || offset != 4 || out.size() != 2)
+    { os << "the invalid character was not reported at offset 4\n"; return 1; }
+
+    /* the sequence of cube.py, and cube.py's long form of the same algorithm. */
+    const auto py = parse_moves("FRuruRUrf", notation::lowercase_inverse);
+    if (!py || format_moves(*py) != "F R U' R' U' R U R' F'" || format_moves(*py, notation::lowercase_inverse) != "FRuruRUrf")
+    { os << "the lowercase-inverse form is not read like cube.py\n"; return 1; }
+    auto long_form = *parse_moves("FRUUURRRUUURURRRFFFRURRRUUURRRFRFFF", notation::lowercase_inverse);
+    const auto short_form = *parse_moves("F R U' R' U' R U R' F' R U R' U' R' F R F'");
+    if (apply_all(long_form) != apply_all(short_form) || canonicalize(long_form) != short_form.size() || long_form != short_form)
+    { os << "the long form of cube.py does not canonicalize to the short one\n"; return 1; }
+
+    const example canonical_examples[] = {
+        { "R R'", "" },
+        { "R R", "R2" },
+        { "R L R", "R2 L" },
+        { "D U", "U D" },
+        { "U R R' U'", "" },
+        { "U D U'", "D" },
+        { "F U D U' D' B2 B2 F'", "" },
+        { "L R2 L' R2", "" }
+    };
+    for (const example& e : canonical_examples) {
+        auto moves = *parse_moves(e.text);
+        const cube before = apply_all(moves);
+        canonicalize(moves);
+        if (format_moves(moves) != e.expected || apply_all(moves) != before || !is_canonical(moves))
+        { os << "\"" << e.text << "\" canonicalizes to \"" << format_moves(moves) << "\"\n"; return 1; }
+    }
+
+    /* random sequences keep their effect, and a canonical sequence stays as it is. */
+    std::uint64_t state = 0x2545f4914f6cdd1dull;
+    for (int k = 0; k < 200; ++k) {
+        std::vector<move_t> moves(k % 40);
+        for (move_t& m : moves) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            /* few faces, so that merges and cancellations are frequent */
+            m = move_t(state % (k % 2 == 0 ? 6 : num_moves));
+        }
+        const cube before = apply_all(moves);
+        canonicalize(moves);
+        const std::vector<move_t> once = moves;
+        canonicalize(moves);
+        if (apply_all(moves) != before || !is_canonical(moves) || moves != once)
+        { os << "canonicalize() changed random sequence " << k << '\n'; return 1; }
+    }
+
+    /* the move-automaton (moves.hpp) accepts exactly the canonical sequences, up to length 4. */
+    std::size_t accepted[5] = {};
+    for (int len = 1; len <= 4; ++len) {
+        std::vector<move_t> moves(len);
+        std::size_t total = 1;
+        for (int i = 0; i < len; ++i)
+        { total *= num_moves; }
+        for (std::size_t code = 0; code < total; ++code) {
+            std::size_t rest = code;
+            int state = sequence_start;
+            bool in_automaton = true;
+            for (int i = 0; i < len; ++i) {
+                moves[i] = move_t(rest % num_moves);
+                rest /= num_moves;
+                in_automaton = in_automaton && (successor_moves[state] >> std::uint8_t(moves[i]) & 1);
+                state = next_sequence_state(moves[i]);
+            }
+            if (in_automaton != is_canonical(moves))
+            { os << "the move-automaton and is_canonical() disagree on " << format_moves(moves) << '\n'; return 1; }
+            accepted[len] += in_automaton;
+        }
+    }
+    if (accepted[1] != 18 || accepted[2] != 243 || accepted[3] != 3240 || accepted[4] != 43254)
+    { os << "the move-automaton does not count the known 18, 243, 3240, 43254 canonical sequences\n"; return 1; }
+
+    os << "notation_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,159 @@
+#include <groubiks/cube/nxn.hpp>
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file nxn.cpp
+ * @brief nxn.hpp unit-test.
+ */
+
+#include <algorithm>
+#include <sstream>
+#include <string>
+#include <string_view>
+#include <vector>
+#include <groubiks/cube/facelets.hpp>
+#include <groubiks/cube/random.hpp>
+
+namespace {
+
+    using namespace groubiks;
+
+    static_assert(cube2::num_moves == 18 && cube3::num_moves == 18 && cube4::num_moves == 36 && cube5::num_moves == 36);
+    static_assert(cube4::num_edges == 24 && cube4::num_centers == 24 && cube5::num_edges == 36 && cube5::num_centers == 54);
+    static_assert(sizeof(cube5) == 150);
+
+    /* every sticker moved by a layer-turn is part of exactly one of its cycles. */
+    template<int N, int Layer>
+    constexpr bool cycles_disjoint() {
+        for (const auto& face : detail::layer_cycles<N, Layer>) {
+            bool seen[6 * N * N] = {};
+            for (const auto& cycle : face) {
+                for (auto s : cycle) {
+                    if (s >= 6 * N * N || seen[s])
+                    { return false; }
+                    seen[s] = true;
+                }
+            }
+        }
+        return true;
+    }
+
+    static_assert(cycles_disjoint<2, 0>() && cycles_disjoint<3, 0>() && cycles_disjoint<4, 0>() &&
+                  cycles_disjoint<4, 1>() && cycles_disjoint<5, 0>() && cycles_disjoint<5, 1>());
+
+    /* the stickers of the corners, which every size shares with the 3x3. */
+    template<int N>
+    std::array<std::uint8_t, 24> corner_stickers(const basic_cube<N>& c) {
+        std::array<std::uint8_t, 24> res{};
+        for (int f = 0, k = 0; f < num_faces; ++f) {
+            for (int row : { 0, N - 1 })
+                for (int col : { 0, N - 1 })
+                { res[k++] = c.stickers[f * N * N + row * N + col]; }
+        }
+        return res;
+    }
+
+    /* checks the moves of size N: four quarter-turns are none, a move and its inverse cancel,
+     * the colors are kept, and the outer moves turn the corners like the 3x3. */
+    template<int N>
+    bool check_moves(std::ostream& os, const std::vector<move_t>& scramble) {
+        using cube_n = basic_cube<N>;
+        cube3 reference = cube3::get_solved();
+        cube_n c = cube_n::get_solved();
+        for (move_t m : scramble) {
+            apply_move(reference, m);
+            apply_move(c, m);
+        }
+        if (corner_stickers(c) != corner_stickers(reference))
+        { os << N << "x" << N << " turns the corners differently than the 3x3\n"; return false; }
+        if (c.is_solved())
+        { os << N << "x" << N << " is solved after a scramble\n"; return false; }
+
+        for (int m = 0; m < cube_n::num_moves; ++m) {
+            cube_n t = c;
+            const int quarter = m - m % 3;
+            for (int i = 0; i < 4; ++i)
+            { apply_move(t, quarter); }
+            apply_move(t, m);
+            apply_move(t, quarter + 2 - m % 3);
+            if (t != c)
+            { os << N << "x" << N << " move " << m << " is no rotation of its layer\n"; return false; }
+        }
+
+        std::array<int, num_faces> colors{};
+        for (auto s : c.stickers)
+        { ++colors[s]; }
+        if (std::ranges::any_of(colors, [](int n) { return n != N * N; }))
+        { os << N << "x" << N << " lost stickers\n"; return false; }
+        return true;
+    }
+
+}
+
+int groubiks::nxn_test(std::ostream& os) {
+    /* the 3x3 shows what to_facelets() shows of the same moves. */
+    color_scheme face_colors{};
+    for (int f = 0; f < num_faces; ++f)
+    { face_colors[f] = color_t(f); }
+    xoshiro256 rng(18);
+    std::vector<move_t> scramble(60);
+    for (move_t& m : scramble)
+    { m = move_t(rng.below(num_moves)); }
+    cube c = cube::get_solved();
+    cube3 c3 = cube3::get_solved();
+    for (move_t m : scramble) {
+        apply_move(c, m);
+        apply_move(c3, m);
+        const facelet_colors expected = to_facelets(c, face_colors);
+        if (!std::equal(expected.begin(), expected.end(), c3.stickers.begin()))
+        { os << "basic_cube<3> differs from cube after " << move_names[int(m)] << '\n'; return 1; }
+    }
+
+    if (!check_moves<2>(os, scramble) || !check_moves<3>(os, scramble) ||
+        !check_moves<4>(os, scramble) || !check_moves<5>(os, scramble))
+    { return 1; }
+
+    /* an inner layer of the 4x4: r = R and the layer next to it, Rw R' turns only the inner one. */
+    cube4 inner = cube4::get_solved();
+    apply_move(inner, layer_move(face_t::R, 1, 1));
+    cube4 outer = cube4::get_solved();
+    apply_move(outer, layer_move(face_t::R, 0, 1));
+    if (inner == outer || corner_stickers(inner) != corner_stickers(cube4::get_solved()))
+    { os << "an inner layer of the 4x4 moves the corners\n"; return 1; }
+
+    /*
+     * the nets after the inner R-layer of the 4x4 and 5x5: the column next to R takes
+     * F to U, U to B, B to D and D to F. B is seen from behind, so its column is next to L.
+     */
+    const auto net_of = [](const auto& c) {
+        std::ostringstream res;
+        res << c;
+        return res.str();
+    };
+    const auto rows = [](std::string_view row, int n) {
+        std::string res;
+        for (int i = 0; i < n; ++i)
+        { res += row; }
+        return res;
+    };
+    if (net_of(inner) != rows("UUFU", 4) + rows("RRRR", 4) + rows("FFDF", 4) + rows("DDBD", 4) + rows("LLLL", 4) + rows("BUBB", 4))
+    { os << "the inner R-layer of the 4x4 moves the wrong stickers: " << net_of(inner) << '\n'; return 1; }
+    cube5 inner5 = cube5::get_solved();
+    apply_move(inner5, layer_move(face_t::R, 1, 1));
+    if (net_of(inner5) != rows("UUUFU", 5) + rows("RRRRR", 5) + rows("FFFDF", 5) + rows("DDDBD", 5) + rows("LLLLL", 5) + rows("BUBBB", 5))
+    { os << "the inner R-layer of the 5x5 moves the wrong stickers: " << net_of(inner5) << '\n'; return 1; }
+
+    /* Rw R' is the inner layer alone. */
+    cube4 wide = cube4::get_solved();
+    apply_move(wide, layer_move(face_t::R, 0, 1));
+    apply_move(wide, layer_move(face_t::R, 1, 1));
+    apply_move(wide, layer_move(face_t::R, 0, 3));
+    if (wide != inner)
+    { os << "Rw R' is not the inner R-layer of the 4x4\n"; return 1; }
+
+    os << "nxn_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,87 @@
+#include <groubiks/cube/random.hpp>
+
+void groubiks::random_cubes(xoshiro256& rng, std::span<cube> out) {
+    for (cube& c : out)
+    { c = random_cube(rng); }
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file random.cpp
+ * @brief random.hpp unit-test.
+ */
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    using namespace groubiks;
+
+    /* the first number of xoshiro256** from the state { 1, 2, 3, 4 } is rotl(2 * 5, 7) * 9. */
+    static_assert(xoshiro256({ 1, 2, 3, 4 })() == 11520);
+    static_assert(xoshiro256::stream(5, 0)() == xoshiro256(5)());
+    static_assert(xoshiro256::stream(5, 1)() != xoshiro256(5)());
+
+    /* every piece once, twists and flips summing to 0, equal permutation-parity. */
+    bool solvable(const cube& c) {
+        int vertices = 0, edges = 0, twist = 0, flip = 0;
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            vertices |= 1 << c.vertex(i);
+            twist += c.vertex_twist(i);
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            edges |= 1 << c.edge(i);
+            flip += c.edge_flip(i);
+        }
+        return vertices == 0xff && edges == 0xfff && twist % 3 == 0 && flip % 2 == 0 &&
+               coord::vertex_parity(c) == coord::edge_parity(c);
+    }
+
+    /* whether `counts` is close to uniform: every bin within 5% of the mean. */
+    bool uniform(const std::vector<int>& counts) {
+        double mean = 0.0;
+        for (int n : counts)
+        { mean += n; }
+        mean /= double(counts.size());
+        for (int n : counts) {
+            if (std::abs(n - mean) > 0.05 * mean)
+            { return false; }
+        }
+        return true;
+    }
+
+}
+
+int groubiks::random_test(std::ostream& os) {
+    constexpr int num_cubes = 120000;
+    std::vector<cube> cubes(num_cubes);
+    xoshiro256 rng(2024);
+    random_cubes(rng, cubes);
+
+    xoshiro256 again(2024);
+    for (const cube& c : cubes) {
+        if (random_cube(again) != c)
+        { os << "random_cubes is not deterministic\n"; return 1; }
+        if (!solvable(c))
+        { os << "random_cube returned an unsolvable cube\n"; return 1; }
+    }
+
+    /* the piece and orientation in a slot, and the parity, are uniform over their values. */
+    std::vector<int> vertex(cube::num_vertices), twist(3), edge(cube::num_edges), flip(2), parity(2);
+    for (const cube& c : cubes) {
+        ++vertex[c.vertex(3)];
+        ++twist[c.vertex_twist(cube::num_vertices - 1)];
+        ++edge[c.edge(cube::num_edges - 1)];
+        ++flip[c.edge_flip(cube::num_edges - 1)];
+        ++parity[coord::edge_parity(c)];
+    }
+    if (!uniform(vertex) || !uniform(twist) || !uniform(edge) || !uniform(flip) || !uniform(parity))
+    { os << "random_cube is not uniform\n"; return 1; }
+
+    os << "random_test passed\n";
+    return 0;
+}
+
+#endif
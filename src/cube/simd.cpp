@@ -0,0 +1,258 @@
+#include <groubiks/cube/simd.hpp>
+
+#include <array>
+#include <cstdint>
+
+#ifdef GROUBIKS_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+    using groubiks::cube;
+    using groubiks::move_t;
+    using word_type = cube::word_type;
+
+    using apply_move_fn = void(*)(cube&, move_t);
+    using apply_sequence_fn = void(*)(cube&, std::span<const move_t>);
+
+    void apply_move_scalar(cube& c, move_t m)
+    { groubiks::apply_move(c, m); }
+
+    void apply_sequence_scalar(cube& c, std::span<const move_t> seq)
+    { groubiks::apply_sequence(c, seq); }
+
+#ifdef GROUBIKS_SIMD_X86
+
+    /*
+     * per-move vector-constants, generated from groubiks::move_table.
+     * the low half of a row is used for the vertices, the high half for the edges.
+     * unused shuffle-bytes are 0x80, which makes pshufb write zero.
+     */
+    struct alignas(32) simd_move_entry {
+        std::uint8_t shuffle[32];
+        std::uint8_t orientation[32];
+    };
+
+    constexpr std::array<simd_move_entry, groubiks::num_moves> make_simd_moves() {
+        std::array<simd_move_entry, groubiks::num_moves> res{};
+        for (int m = 0; m < groubiks::num_moves; ++m) {
+            const groubiks::move_entry& e = groubiks::move_table[m];
+            for (int i = 0; i < 16; ++i) {
+                res[m].shuffle[i] = i < cube::num_vertices ? e.vertex_perm[i] : 0x80;
+                res[m].shuffle[16 + i] = i < cube::num_edges ? e.edge_perm[i] : 0x80;
+                res[m].orientation[i] = i < cube::num_vertices
+                    ? std::uint8_t(e.vertex_twists >> (i * cube::vertex_field_bits)) : 0;
+                res[m].orientation[16 + i] = i < cube::num_edges
+                    ? std::uint8_t((e.edge_flips >> (i * cube::edge_field_bits)) & cube::edge_field_mask) : 0;
+            }
+        }
+        return res;
+    }
+
+    constexpr std::array<simd_move_entry, groubiks::num_moves> simd_moves = make_simd_moves();
+
+    constexpr word_type byte_fields_lo = 0x1f1f1f1f1f1f1f1full;
+    constexpr word_type byte_fields_hi = 0x1f1f1f1full;
+
+    /* edges 0..7 go to the low, edges 8..11 to the high word. */
+    inline void unpack_edges(word_type e, word_type& lo, word_type& hi) {
+        lo = 0; hi = 0;
+        for (int i = 0; i < 8; ++i)
+        { lo |= ((e >> (i * cube::edge_field_bits)) & cube::edge_field_mask) << (i * 8); }
+        for (int i = 0; i < 4; ++i)
+        { hi |= ((e >> ((i + 8) * cube::edge_field_bits)) & cube::edge_field_mask) << (i * 8); }
+    }
+
+    inline word_type pack_edges(word_type lo, word_type hi) {
+        word_type e = 0;
+        for (int i = 0; i < 8; ++i)
+        { e |= ((lo >> (i * 8)) & cube::edge_field_mask) << (i * cube::edge_field_bits); }
+        for (int i = 0; i < 4; ++i)
+        { e |= ((hi >> (i * 8)) & cube::edge_field_mask) << ((i + 8) * cube::edge_field_bits); }
+        return e;
+    }
+
+    /**
+     * @brief ssse3: vertices and edges in two xmm-registers.
+     *        twists are fixed by subtracting 3 where the sum exceeds 2,
+     *        flips are plain xor.
+     */
+    __attribute__((target("ssse3")))
+    inline void ssse3_move(__m128i& v, __m128i& e, move_t m) {
+        const simd_move_entry& s = simd_moves[std::uint8_t(m)];
+        const __m128i* shuffle = reinterpret_cast<const __m128i*>(s.shuffle);
+        const __m128i* orientation = reinterpret_cast<const __m128i*>(s.orientation);
+        v = _mm_add_epi8(_mm_shuffle_epi8(v, _mm_load_si128(shuffle)), _mm_load_si128(orientation));
+        v = _mm_sub_epi8(v, _mm_and_si128(_mm_cmpgt_epi8(v, _mm_set1_epi8(0x2f)), _mm_set1_epi8(0x30)));
+        e = _mm_xor_si128(_mm_shuffle_epi8(e, _mm_load_si128(shuffle + 1)), _mm_load_si128(orientation + 1));
+    }
+
+    __attribute__((target("ssse3")))
+    void apply_sequence_ssse3(cube& c, std::span<const move_t> seq) {
+        word_type lo, hi;
+        unpack_edges(c.edge_bits, lo, hi);
+        __m128i v = _mm_cvtsi64_si128(static_cast<long long>(c.vertex_bits));
+        __m128i e = _mm_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo));
+        for (move_t m : seq)
+        { ssse3_move(v, e, m); }
+        c.vertex_bits = static_cast<word_type>(_mm_cvtsi128_si64(v));
+        c.edge_bits = pack_edges(static_cast<word_type>(_mm_cvtsi128_si64(e)),
+            static_cast<word_type>(_mm_cvtsi128_si64(_mm_unpackhi_epi64(e, e))));
+    }
+
+    __attribute__((target("ssse3")))
+    void apply_move_ssse3(cube& c, move_t m)
+    { apply_sequence_ssse3(c, std::span<const move_t>(&m, 1)); }
+
+    /**
+     * @brief avx2: vertices in the low, edges in the high lane of one ymm-register.
+     *        vpshufb shuffles within lanes, so one shuffle moves all 20 pieces.
+     *        both orientations are added and reduced by a per-lane modulus
+     *        (subtract 0x30 above 0x2f for vertices, 0x20 above 0x1f for edges).
+     */
+    __attribute__((target("avx2")))
+    inline __m256i avx2_move(__m256i c, move_t m, __m256i limit, __m256i modulus) {
+        const simd_move_entry& s = simd_moves[std::uint8_t(m)];
+        c = _mm256_shuffle_epi8(c, _mm256_load_si256(reinterpret_cast<const __m256i*>(s.shuffle)));
+        c = _mm256_add_epi8(c, _mm256_load_si256(reinterpret_cast<const __m256i*>(s.orientation)));
+        return _mm256_sub_epi8(c, _mm256_and_si256(_mm256_cmpgt_epi8(c, limit), modulus));
+    }
+
+    __attribute__((target("avx2,bmi2")))
+    void apply_sequence_avx2(cube& c, std::span<const move_t> seq) {
+        const __m256i limit = _mm256_set_m128i(_mm_set1_epi8(0x1f), _mm_set1_epi8(0x2f));
+        const __m256i modulus = _mm256_set_m128i(_mm_set1_epi8(0x20), _mm_set1_epi8(0x30));
+        const word_type lo = _pdep_u64(c.edge_bits, byte_fields_lo);
+        const word_type hi = _pdep_u64(c.edge_bits >> 40, byte_fields_hi);
+        __m256i r = _mm256_set_epi64x(static_cast<long long>(hi), static_cast<long long>(lo),
+            0, static_cast<long long>(c.vertex_bits));
+        for (move_t m : seq)
+        { r = avx2_move(r, m, limit, modulus); }
+        const __m128i e = _mm256_extracti128_si256(r, 1);
+        c.vertex_bits = static_cast<word_type>(_mm_cvtsi128_si64(_mm256_castsi256_si128(r)));
+        c.edge_bits = _pext_u64(static_cast<word_type>(_mm_cvtsi128_si64(e)), byte_fields_lo) |
+            _pext_u64(static_cast<word_type>(_mm_extract_epi64(e, 1)), byte_fields_hi) << 40;
+    }
+
+    __attribute__((target("avx2,bmi2")))
+    void apply_move_avx2(cube& c, move_t m)
+    { apply_sequence_avx2(c, std::span<const move_t>(&m, 1)); }
+
+#endif
+
+    struct kernel_fns {
+        groubiks::simd::kernel_t kernel;
+        apply_move_fn move;
+        apply_sequence_fn sequence;
+    };
+
+    kernel_fns fns_for(groubiks::simd::kernel_t k) {
+        switch (k) {
+#ifdef GROUBIKS_SIMD_X86
+        case groubiks::simd::kernel_t::avx2:
+            return { k, &apply_move_avx2, &apply_sequence_avx2 };
+        case groubiks::simd::kernel_t::ssse3:
+            return { k, &apply_move_ssse3, &apply_sequence_ssse3 };
+#endif
+        default:
+            return { groubiks::simd::kernel_t::scalar, &apply_move_scalar, &apply_sequence_scalar };
+        }
+    }
+
+    kernel_fns detect() {
+        using groubiks::simd::kernel_t;
+        for (kernel_t k : { kernel_t::avx2, kernel_t::ssse3 }) {
+            if (groubiks::simd::kernel_supported(k))
+            { return fns_for(k); }
+        }
+        return fns_for(kernel_t::scalar);
+    }
+
+    kernel_fns& active() {
+        static kernel_fns fns = detect();
+        return fns;
+    }
+
+}
+
+std::string_view groubiks::simd::kernel_name(kernel_t k) {
+    switch (k) {
+    case kernel_t::ssse3: return "ssse3";
+    case kernel_t::avx2:  return "avx2";
+    default:              return "scalar";
+    }
+}
+
+bool groubiks::simd::kernel_supported(kernel_t k) {
+    switch (k) {
+    case kernel_t::scalar:
+        return true;
+#ifdef GROUBIKS_SIMD_X86
+    case kernel_t::ssse3:
+        return __builtin_cpu_supports("ssse3");
+    case kernel_t::avx2:
+        return __builtin_cpu_supports("avx2") && __builtin_cpu_supports("bmi2");
+#endif
+    default:
+        return false;
+    }
+}
+
+groubiks::simd::kernel_t groubiks::simd::active_kernel()
+{ return active().kernel; }
+
+bool groubiks::simd::select_kernel(kernel_t k) {
+    if (!kernel_supported(k))
+    { return false; }
+    active() = fns_for(k);
+    return true;
+}
+
+void groubiks::simd::apply_move(cube& c, move_t m)
+{ active().move(c, m); }
+
+void groubiks::simd::apply_sequence(cube& c, std::span<const move_t> seq)
+{ active().sequence(c, seq); }
+
+#ifdef BUILD_TESTS
+
+#include <vector>
+
+/**
+ * @brief every supported kernel must match the scalar reference bit for bit.
+ */
+int groubiks::simd::simd_test(std::ostream& os) {
+    const kernel_t detected = active_kernel();
+    std::vector<move_t> seq(4096);
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (auto& m : seq) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        m = move_t(state % num_moves);
+    }
+
+    for (kernel_t k : { kernel_t::scalar, kernel_t::ssse3, kernel_t::avx2 }) {
+        if (!select_kernel(k))
+        { os << "kernel " << kernel_name(k) << " not supported, skipped\n"; continue; }
+
+        cube reference = cube::get_solved();
+        cube single = cube::get_solved();
+        for (move_t m : seq) {
+            groubiks::apply_move(reference, m);
+            simd::apply_move(single, m);
+            if (single != reference)
+            { os << "kernel " << kernel_name(k) << ": apply_move differs from scalar\n"; return 1; }
+        }
+        cube whole = cube::get_solved();
+        simd::apply_sequence(whole, seq);
+        if (whole != reference)
+        { os << "kernel " << kernel_name(k) << ": apply_sequence differs from scalar\n"; return 1; }
+        os << "kernel " << kernel_name(k) << " matches scalar\n";
+    }
+    select_kernel(detected);
+
+    os << "simd_test passed\n";
+    return 0;
+}
+
+#endif
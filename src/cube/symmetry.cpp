@@ -0,0 +1,65 @@
+#include <groubiks/cube/symmetry.hpp>
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file symmetry.cpp
+ * @brief symmetry.hpp unit-test.
+ */
+
+namespace {
+
+    using namespace groubiks;
+
+    /* the identity, and the reflection turning R into L'. */
+    static_assert(conjugate(move_cubes[int(move_t::R)], 0) == move_cubes[int(move_t::R)]);
+    static_assert(conjugate_move(move_t::R, 1) == move_t::Lp);
+    static_assert(conjugate_move(move_t::U, 1) == move_t::Up);
+    /* URF3 cycles the axes U -> R -> F. */
+    static_assert(move_face(conjugate_move(move_t::U, 16)) == face_t::R ||
+                  move_face(conjugate_move(move_t::U, 16)) == face_t::F);
+
+}
+
+int groubiks::symmetry_test(std::ostream& os) {
+    for (int s = 0; s < num_symmetries; ++s) {
+        bool keeps_ud = true;
+        for (int m = 0; m < num_moves; ++m) {
+            if (detail::symmetry_moves[s][m] >= num_moves)
+            { os << "symmetry " << s << " does not conjugate " << move_names[m] << " into a move\n"; return 1; }
+            const face_t f = move_face(conjugate_move(move_t(m), s));
+            const face_t from = move_face(move_t(m));
+            if ((from == face_t::U || from == face_t::D) && f != face_t::U && f != face_t::D)
+            { keeps_ud = false; }
+        }
+        if (keeps_ud != (s < num_ud_symmetries))
+        { os << "symmetry " << s << (keeps_ud ? " keeps" : " moves") << " the U-D-axis\n"; return 1; }
+        for (int t = 0; t < s; ++t) {
+            if (detail::symmetry_moves[s] == detail::symmetry_moves[t])
+            { os << "symmetries " << t << " and " << s << " are the same\n"; return 1; }
+        }
+    }
+
+    /* conjugation is a homomorphism, so a conjugated sequence is the sequence of conjugated moves. */
+    const move_t scramble[] = { move_t::R, move_t::U2, move_t::Fp, move_t::L, move_t::D2,
+        move_t::Bp, move_t::R2, move_t::F, move_t::Up, move_t::L2, move_t::B, move_t::Dp };
+    cube c = cube::get_solved();
+    apply_sequence(c, scramble);
+    for (int s = 0; s < num_symmetries; ++s) {
+        cube moved = cube::get_solved();
+        for (move_t m : scramble)
+        { apply_move(moved, conjugate_move(m, s)); }
+        const cube conjugated = conjugate(c, s);
+        if (moved != conjugated)
+        { os << "conjugating by symmetry " << s << " does not commute with the moves\n"; return 1; }
+        if (conjugate(conjugated, inverse_symmetry(s)) != c)
+        { os << "symmetry " << inverse_symmetry(s) << " does not undo symmetry " << s << '\n'; return 1; }
+        if ((s < num_ud_symmetries) != (inverse_symmetry(s) < num_ud_symmetries))
+        { os << "the U-D-symmetries are no subgroup\n"; return 1; }
+    }
+
+    os << "symmetry_test passed\n";
+    return 0;
+}
+
+#endif
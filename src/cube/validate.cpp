@@ -0,0 +1,264 @@
+#include <groubiks/cube/validate.hpp>
+#include <groubiks/cube/simd.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <cstring>
+
+#ifdef GROUBIKS_SIMD_X86
+    #include <immintrin.h>
+#endif
+
+namespace {
+
+    using byte_type = groubiks::cube_batch::byte_type;
+    using groubiks::cube;
+
+    /**
+     * @brief the checks on unpacked pieces, one byte each as in a cube_batch.
+     *        the avx2-kernel below does exactly the same arithmetic, lane by lane.
+     */
+    std::uint8_t validate_bytes(const byte_type (&v)[cube::num_vertices], const byte_type (&e)[cube::num_edges]) {
+        std::uint8_t res = 0;
+        unsigned vertex_set = 0, edge_set = 0;
+        int twist = 0, flip = 0;
+        for (byte_type b : v) {
+            if ((b & 0xc8) != 0 || (b & 0x30) == 0x30)
+            { res |= groubiks::invalid_field; }
+            if ((b & 0x0f) < cube::num_vertices)
+            { vertex_set |= 1u << (b & 0x0f); }
+            twist += b >> 4 & 0x3;
+        }
+        for (byte_type b : e) {
+            if ((b & 0xe0) != 0 || (b & 0x0f) >= cube::num_edges)
+            { res |= groubiks::invalid_field; }
+            else
+            { edge_set |= 1u << (b & 0x0f); }
+            flip ^= b >> 4 & 0x1;
+        }
+        if (vertex_set != 0xff || edge_set != 0xfff)
+        { res |= groubiks::duplicate_piece; }
+        if (twist % 3 != 0)
+        { res |= groubiks::twisted_vertex; }
+        if (flip != 0)
+        { res |= groubiks::flipped_edge; }
+        /* the inversions of a permutation, counted as the earlier pieces above each piece. */
+        if ((res & groubiks::duplicate_piece) == 0) {
+            unsigned seen = 0;
+            int inversions = 0;
+            for (byte_type b : v) {
+                inversions += std::popcount(seen >> (b & 0x0f));
+                seen |= 1u << (b & 0x0f);
+            }
+            seen = 0;
+            for (byte_type b : e) {
+                inversions += std::popcount(seen >> (b & 0x0f));
+                seen |= 1u << (b & 0x0f);
+            }
+            if (inversions % 2 != 0)
+            { res |= groubiks::odd_permutation; }
+        }
+        return res;
+    }
+
+    std::size_t validate_generic(const groubiks::cube_batch& batch, std::uint8_t* errors) {
+        std::size_t res = 0;
+        for (std::size_t k = 0; k < batch.size(); ++k) {
+            byte_type v[cube::num_vertices], e[cube::num_edges];
+            for (int i = 0; i < cube::num_vertices; ++i)
+            { v[i] = batch.vertex_slot(i)[k]; }
+            for (int i = 0; i < cube::num_edges; ++i)
+            { e[i] = batch.edge_slot(i)[k]; }
+            errors[k] = validate_bytes(v, e);
+            res += errors[k] != 0;
+        }
+        return res;
+    }
+
+#ifdef GROUBIKS_SIMD_X86
+
+    /* the validation_error-bits of the 32 cubes starting at `k`. */
+    __attribute__((target("avx2")))
+    __m256i validate_avx2_block(const groubiks::cube_batch& batch, std::size_t k) {
+        /* piece -> its bit in the set of pieces, for both 128-bit lanes. */
+        const __m256i vertex_bit = _mm256_setr_epi8(1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0,
+                                                    1, 2, 4, 8, 16, 32, 64, -128, 0, 0, 0, 0, 0, 0, 0, 0);
+        const __m256i edge_bit_low = vertex_bit;
+        const __m256i edge_bit_high = _mm256_setr_epi8(0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 0, 0, 0, 0,
+                                                       0, 0, 0, 0, 0, 0, 0, 0, 1, 2, 4, 8, 0, 0, 0, 0);
+        /* sums 0..15 divisible by 3. */
+        const __m256i divisible = _mm256_setr_epi8(-1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1,
+                                                   -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1, 0, 0, -1);
+        const __m256i zero = _mm256_setzero_si256();
+        const __m256i nibble = _mm256_set1_epi8(0x0f);
+        const __m256i twist_bits = _mm256_set1_epi8(0x30);
+
+        __m256i vertices[cube::num_vertices], edges[cube::num_edges];
+        __m256i bad_field = zero, vertex_set = zero, edge_set_low = zero, edge_set_high = zero, twist = zero, flip = zero;
+        for (int i = 0; i < cube::num_vertices; ++i) {
+            const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.vertex_slot(i) + k));
+            vertices[i] = _mm256_and_si256(b, nibble);
+            bad_field = _mm256_or_si256(bad_field, _mm256_andnot_si256(
+                _mm256_cmpeq_epi8(_mm256_and_si256(b, _mm256_set1_epi8(char(0xc8))), zero),
+                _mm256_set1_epi8(-1)));
+            bad_field = _mm256_or_si256(bad_field, _mm256_cmpeq_epi8(_mm256_and_si256(b, twist_bits), twist_bits));
+            vertex_set = _mm256_or_si256(vertex_set, _mm256_shuffle_epi8(vertex_bit, vertices[i]));
+            twist = _mm256_add_epi8(twist, _mm256_and_si256(_mm256_srli_epi16(b, 4), _mm256_set1_epi8(0x3)));
+        }
+        for (int i = 0; i < cube::num_edges; ++i) {
+            const __m256i b = _mm256_load_si256(reinterpret_cast<const __m256i*>(batch.edge_slot(i) + k));
+            edges[i] = _mm256_and_si256(b, nibble);
+            const __m256i in_range = _mm256_and_si256(
+                _mm256_cmpeq_epi8(_mm256_and_si256(b, _mm256_set1_epi8(char(0xe0))), zero),
+                _mm256_cmpeq_epi8(_mm256_max_epu8(edges[i], _mm256_set1_epi8(cube::num_edges - 1)),
+                                  _mm256_set1_epi8(cube::num_edges - 1)));
+            bad_field = _mm256_or_si256(bad_field, _mm256_andnot_si256(in_range, _mm256_set1_epi8(-1)));
+            /* out-of-range pieces would alias in the lookup, they stay out of the set. */
+            const __m256i piece = _mm256_or_si256(edges[i], _mm256_andnot_si256(in_range, _mm256_set1_epi8(-128)));
+            edge_set_low = _mm256_or_si256(edge_set_low, _mm256_shuffle_epi8(edge_bit_low, piece));
+            edge_set_high = _mm256_or_si256(edge_set_high, _mm256_shuffle_epi8(edge_bit_high, piece));
+            flip = _mm256_xor_si256(flip, b);
+        }
+
+        const __m256i complete = _mm256_and_si256(_mm256_cmpeq_epi8(vertex_set, _mm256_set1_epi8(-1)),
+            _mm256_and_si256(_mm256_cmpeq_epi8(edge_set_low, _mm256_set1_epi8(-1)),
+                             _mm256_cmpeq_epi8(edge_set_high, _mm256_set1_epi8(0x0f))));
+        /* twist <= 24: 16 = 1 mod 3, so the nibbles can be added before the lookup. */
+        twist = _mm256_add_epi8(_mm256_and_si256(twist, nibble), _mm256_and_si256(_mm256_srli_epi16(twist, 4), nibble));
+        const __m256i twist_ok = _mm256_shuffle_epi8(divisible, twist);
+        const __m256i flip_bad = _mm256_cmpeq_epi8(_mm256_and_si256(flip, _mm256_set1_epi8(0x10)), _mm256_set1_epi8(0x10));
+
+        __m256i parity = zero;
+        for (int i = 0; i < cube::num_vertices; ++i)
+            for (int j = i + 1; j < cube::num_vertices; ++j)
+            { parity = _mm256_xor_si256(parity, _mm256_cmpgt_epi8(vertices[i], vertices[j])); }
+        for (int i = 0; i < cube::num_edges; ++i)
+            for (int j = i + 1; j < cube::num_edges; ++j)
+            { parity = _mm256_xor_si256(parity, _mm256_cmpgt_epi8(edges[i], edges[j])); }
+
+        __m256i res = _mm256_and_si256(bad_field, _mm256_set1_epi8(groubiks::invalid_field));
+        res = _mm256_or_si256(res, _mm256_andnot_si256(complete, _mm256_set1_epi8(groubiks::duplicate_piece)));
+        res = _mm256_or_si256(res, _mm256_andnot_si256(twist_ok, _mm256_set1_epi8(groubiks::twisted_vertex)));
+        res = _mm256_or_si256(res, _mm256_and_si256(flip_bad, _mm256_set1_epi8(groubiks::flipped_edge)));
+        res = _mm256_or_si256(res, _mm256_and_si256(_mm256_and_si256(parity, complete), _mm256_set1_epi8(groubiks::odd_permutation)));
+        return res;
+    }
+
+    __attribute__((target("avx2")))
+    std::size_t validate_avx2(const groubiks::cube_batch& batch, std::uint8_t* errors) {
+        std::size_t res = 0;
+        std::size_t k = 0;
+        for (; k + 32 <= batch.size(); k += 32) {
+            const __m256i block = validate_avx2_block(batch, k);
+            _mm256_storeu_si256(reinterpret_cast<__m256i*>(errors + k), block);
+            res += 32 - std::popcount(unsigned(_mm256_movemask_epi8(_mm256_cmpeq_epi8(block, _mm256_setzero_si256()))));
+        }
+        /* the slot-arrays are padded to 32 bytes, only the output has to be cut. */
+        if (k < batch.size()) {
+            alignas(32) std::uint8_t tail[32];
+            _mm256_store_si256(reinterpret_cast<__m256i*>(tail), validate_avx2_block(batch, k));
+            std::memcpy(errors + k, tail, batch.size() - k);
+            res += std::size_t(std::count_if(errors + k, errors + batch.size(), [](std::uint8_t e) { return e != 0; }));
+        }
+        return res;
+    }
+
+#endif
+
+}
+
+std::uint8_t groubiks::validate(const cube& c) {
+    byte_type v[cube::num_vertices], e[cube::num_edges];
+    for (int i = 0; i < cube::num_vertices; ++i)
+    { v[i] = byte_type(c.vertex_bits >> (i * cube::vertex_field_bits)); }
+    for (int i = 0; i < cube::num_edges; ++i)
+    { e[i] = byte_type((c.edge_bits >> (i * cube::edge_field_bits)) & cube::edge_field_mask); }
+    const std::uint8_t stray = (c.edge_bits >> (cube::num_edges * cube::edge_field_bits)) != 0 ? invalid_field : 0;
+    return validate_bytes(v, e) | stray;
+}
+
+std::size_t groubiks::validate(const cube_batch& batch, std::span<std::uint8_t> errors) {
+#ifdef GROUBIKS_SIMD_X86
+    if (simd::active_kernel() == simd::kernel_t::avx2)
+    { return validate_avx2(batch, errors.data()); }
+#endif
+    return validate_generic(batch, errors.data());
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file validate.cpp
+ * @brief validate.hpp unit-test.
+ */
+
+#include <vector>
+#include <groubiks/cube/random.hpp>
+
+int groubiks::validate_test(std::ostream& os) {
+    xoshiro256 rng(16);
+    const cube solved = cube::get_solved();
+    if (validate(solved) != 0)
+    { os << "the solved cube is not valid\n"; return 1; }
+
+    /* a single defect of each kind. */
+    cube twisted = solved;
+    twisted.set_vertex(0, 0, 1);
+    cube flipped = solved;
+    flipped.set_edge(5, 5, 1);
+    cube swapped = solved;
+    swapped.set_edge(0, 1, 0);
+    swapped.set_edge(1, 0, 0);
+    cube duplicate = solved;
+    duplicate.set_vertex(2, 3, 0);
+    cube out_of_range = solved;
+    out_of_range.set_edge(11, 12, 0);
+    cube stray = solved;
+    stray.edge_bits |= cube::word_type(1) << 62;
+    const std::pair<cube, std::uint8_t> defects[] = {
+        { twisted, twisted_vertex }, { flipped, flipped_edge }, { swapped, odd_permutation },
+        { duplicate, duplicate_piece }, { out_of_range, invalid_field | duplicate_piece }, { stray, invalid_field }
+    };
+    for (const auto& [c, expected] : defects) {
+        if (validate(c) != expected)
+        { os << "validate() returned " << int(validate(c)) << " instead of " << int(expected) << '\n'; return 1; }
+    }
+
+    /* random cubes, a third of them damaged in random bytes, through every kernel. */
+    constexpr std::size_t num = 3000 + 17;
+    cube_batch batch(num);
+    std::vector<std::uint8_t> expected(num);
+    std::size_t num_invalid = 0;
+    for (std::size_t k = 0; k < num; ++k) {
+        batch.set(k, random_cube(rng));
+        if (k % 3 == 0) {
+            const int slot = int(rng.below(cube_batch::num_slots));
+            byte_type* data = slot < cube::num_vertices ? batch.vertex_slot(slot) : batch.edge_slot(slot - cube::num_vertices);
+            data[k] = byte_type(rng());
+        }
+        byte_type v[cube::num_vertices], e[cube::num_edges];
+        for (int i = 0; i < cube::num_vertices; ++i)
+        { v[i] = batch.vertex_slot(i)[k]; }
+        for (int i = 0; i < cube::num_edges; ++i)
+        { e[i] = batch.edge_slot(i)[k]; }
+        expected[k] = validate_bytes(v, e);
+        num_invalid += expected[k] != 0;
+        if (k % 3 != 0 && expected[k] != 0)
+        { os << "random_cube " << k << " is not valid\n"; return 1; }
+    }
+
+    const simd::kernel_t detected = simd::active_kernel();
+    for (simd::kernel_t kernel : { simd::kernel_t::scalar, simd::kernel_t::avx2 }) {
+        if (!simd::select_kernel(kernel))
+        { continue; }
+        std::vector<std::uint8_t> errors(num, 0xff);
+        if (validate(batch, errors) != num_invalid || errors != expected)
+        { os << "validate() of a batch differs per cube with kernel " << simd::kernel_name(kernel) << '\n'; return 1; }
+    }
+    simd::select_kernel(detected);
+
+    os << "validate_test passed\n";
+    return 0;
+}
+
+#endif
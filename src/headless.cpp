@@ -0,0 +1,59 @@
+#include <cstdlib>
+#include <fstream>
+#include <iostream>
+#include <memory>
+#include <string_view>
+#include <groubiks/solver/batch.hpp>
+
+/**
+ * @brief groubiks --batch [file] [--threads n] [--max-length n] [--timeout ms] [--tables path] [--optimal-depth n]
+ *        solves every line of `file` (or stdin) and writes the solutions to stdout,
+ *        the statistics to stderr. nothing of the application, the window or the renderer
+ *        is touched, so this runs on machines without a display or gpu.
+ *        states close to solved are solved optimally by the bidirectional solver with a table
+ *        of depth --optimal-depth (default 5, 0: two-phase only).
+ * @returns 0 if every line was solved.
+ */
+int groubiks_run_batch(int argc, char** argv) {
+    groubiks::solver::batch_config config;
+    const char* input_path = nullptr;
+    const char* table_path = nullptr;
+    int optimal_depth = 5;
+    for (int i = 2; i < argc; ++i) {
+        const std::string_view arg = argv[i];
+        const bool has_value = i + 1 < argc;
+        if (arg == "--threads" && has_value)
+        { config.threads = std::atoi(argv[++i]); }
+        else if (arg == "--max-length" && has_value)
+        { config.max_length = std::atoi(argv[++i]); }
+        else if (arg == "--timeout" && has_value)
+        { config.timeout = std::chrono::milliseconds(std::atoi(argv[++i])); }
+        else if (arg == "--tables" && has_value)
+        { table_path = argv[++i]; }
+        else if (arg == "--optimal-depth" && has_value)
+        { optimal_depth = std::atoi(argv[++i]); }
+        else if (!arg.starts_with("--") && input_path == nullptr)
+        { input_path = argv[i]; }
+        else {
+            std::cerr << "usage: groubiks --batch [file] [--threads n] [--max-length n] [--timeout ms] [--tables path] [--optimal-depth n]\n";
+            return EXIT_FAILURE;
+        }
+    }
+
+    std::ifstream file;
+    if (input_path != nullptr) {
+        file.open(input_path);
+        if (!file) {
+            std::cerr << "could not open " << input_path << "\n";
+            return EXIT_FAILURE;
+        }
+    }
+    const auto engine = table_path != nullptr
+        ? std::make_unique<groubiks::solver::kociemba>(table_path)
+        : std::make_unique<groubiks::solver::kociemba>();
+    const auto short_solver = optimal_depth > 0 ? std::make_unique<groubiks::solver::bidirectional>(optimal_depth) : nullptr;
+    const groubiks::solver::batch_report report = groubiks::solver::solve_batch(*engine,
+        input_path != nullptr ? file : std::cin, std::cout, config, short_solver.get());
+    std::cerr << report << "\n";
+    return report.failed == 0 ? EXIT_SUCCESS : EXIT_FAILURE;
+}
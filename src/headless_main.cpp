@@ -0,0 +1,17 @@
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+
+/* headless.cpp: the solver without window or renderer. */
+int groubiks_run_batch(int argc, char** argv);
+
+/**
+ * @brief groubiks_headless --batch [file] [options]: the batch-mode of groubiks (see headless.cpp)
+ *        as an executable of its own, which builds without glfw and vulkan.
+ */
+int main(int argc, char** argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "--batch")
+    { return groubiks_run_batch(argc, argv); }
+    std::cerr << "usage: groubiks_headless --batch [file] [--threads n] [--max-length n] [--timeout ms] [--tables path] [--optimal-depth n]\n";
+    return EXIT_FAILURE;
+}
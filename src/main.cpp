@@ -1,8 +1,15 @@
 
 #include <iostream>
+#include <string_view>
 #include <groubiks/groubiks.hpp>
 
+/* headless.cpp: the solver without window or renderer. */
+int groubiks_run_batch(int argc, char** argv);
+
 int main(int argc, char** argv) {
+    if (argc > 1 && std::string_view(argv[1]) == "--batch")
+    { return groubiks_run_batch(argc, argv); }
+
     groubiks::application app;
 
     if (app.initialize() != GROUBIKS_SUCCESS) {
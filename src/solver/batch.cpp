@@ -0,0 +1,231 @@
+#include <groubiks/solver/batch.hpp>
+
+#include <algorithm>
+#include <condition_variable>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <groubiks/cube/facelets.hpp>
+#include <groubiks/cube/notation.hpp>
+#include <groubiks/cube/validate.hpp>
+#include <groubiks/solver/work_stealing.hpp>
+
+namespace {
+
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr std::string_view face_letters = "URFDLB";
+
+    std::string_view trim(std::string_view s) {
+        const std::size_t begin = s.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos)
+        { return {}; }
+        return s.substr(begin, s.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+}
+
+double groubiks::solver::batch_report::latency_percentile(double p) const {
+    if (latencies.empty())
+    { return 0.0; }
+    const std::size_t idx = std::size_t(std::clamp(p, 0.0, 1.0) * double(latencies.size() - 1) + 0.5);
+    return latencies[idx];
+}
+
+std::ostream& groubiks::solver::operator<<(std::ostream& os, const batch_report& r) {
+    return os << r.states << " states (" << r.failed << " failed, " << r.optimal << " optimal) in " << r.seconds << " s, "
+              << r.states_per_second() << " states/s, latency p50 " << r.latency_percentile(0.5) * 1e3
+              << " ms, p90 " << r.latency_percentile(0.9) * 1e3 << " ms, p99 " << r.latency_percentile(0.99) * 1e3
+              << " ms, max " << r.latency_percentile(1.0) * 1e3 << " ms";
+}
+
+std::optional<groubiks::cube> groubiks::solver::parse_state(std::string_view line, int* scramble_length) {
+    line = trim(line);
+    if (scramble_length != nullptr)
+    { *scramble_length = -1; }
+    if (line.size() == num_facelets && line.find_first_not_of(face_letters) == std::string_view::npos) {
+        facelet_colors colors{};
+        for (int i = 0; i < num_facelets; ++i)
+        { colors[i] = default_scheme[face_letters.find(line[i])]; }
+        return from_facelets(colors);
+    }
+    const std::optional<std::vector<move_t>> moves = parse_moves(line);
+    if (!moves)
+    { return std::nullopt; }
+    cube res = cube::get_solved();
+    apply_sequence(res, *moves);
+    if (scramble_length != nullptr)
+    { *scramble_length = int(moves->size()); }
+    return res;
+}
+
+groubiks::solver::batch_report groubiks::solver::solve_batch(const kociemba& engine, std::istream& in, std::ostream& out,
+    const batch_config& config, const bidirectional* short_solver)
+{
+    const int num_workers = config.threads > 0 ? config.threads : int(std::max(1u, std::thread::hardware_concurrency()));
+    const auto start = clock_type::now();
+
+    /* the input, and the index of the next line read from it. */
+    std::mutex input_lock;
+    std::size_t next_input = 0;
+    /*
+     * results of lines after `next_output`, waiting for the earlier ones. a line is only read
+     * while fewer than max_pending lines are unwritten, so one slow state cannot let the others
+     * read ahead and buffer without bound.
+     */
+    std::mutex output_lock;
+    std::condition_variable output_advanced;
+    std::size_t next_output = 0;
+    std::map<std::size_t, std::string> pending;
+    const std::size_t max_pending = 4 * std::size_t(num_workers);
+    batch_report res;
+
+    run_workers(num_workers, [&](int) {
+        std::string line;
+        while (true) {
+            std::size_t idx;
+            {
+                std::lock_guard lock(input_lock);
+                {
+                    std::unique_lock wait(output_lock);
+                    output_advanced.wait(wait, [&] { return next_input - next_output < max_pending; });
+                }
+                do {
+                    if (!std::getline(in, line))
+                    { return; }
+                } while (trim(line).empty() || trim(line).front() == '#');
+                idx = next_input++;
+            }
+
+            std::string result;
+            std::optional<double> latency;
+            bool optimal = false;
+            int scramble_length;
+            const std::optional<cube> c = parse_state(line, &scramble_length);
+            if (!c)
+            { result = "error: unreadable state"; }
+            else if (validate(*c) != 0)
+            { result = "error: invalid state"; }
+            else {
+                const auto solve_start = clock_type::now();
+                int short_length = std::min(config.optimal_length, config.max_length);
+                if (scramble_length <= config.optimal_scramble_length)
+                { short_length = std::max(short_length, std::min(scramble_length, config.max_length)); }
+                solution s;
+                if (short_solver != nullptr && short_length >= 0) {
+                    s = short_solver->solve(*c, short_length, config.timeout);
+                    optimal = s.found;
+                }
+                if (!s.found)
+                { s = engine.solve(*c, config.max_length, config.timeout); }
+                latency = std::chrono::duration<double>(clock_type::now() - solve_start).count();
+                if (s.found)
+                { result = format_moves(s.moves); }
+                else
+                { result = "error: no solution within " + std::to_string(config.max_length) + " moves"; }
+            }
+
+            std::lock_guard lock(output_lock);
+            ++res.states;
+            res.optimal += optimal;
+            res.failed += result.starts_with("error");
+            if (latency)
+            { res.latencies.push_back(*latency); }
+            pending.emplace(idx, std::move(result));
+            for (auto it = pending.begin(); it != pending.end() && it->first == next_output; it = pending.erase(it)) {
+                out << it->second << '\n';
+                ++next_output;
+            }
+            out.flush();
+            /* only the thread holding input_lock ever waits. */
+            output_advanced.notify_one();
+        }
+    });
+
+    res.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    std::sort(res.latencies.begin(), res.latencies.end());
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file batch.cpp
+ * @brief batch.hpp unit-test.
+ */
+
+#include <sstream>
+#include <groubiks/cube/random.hpp>
+
+int groubiks::solver::batch_test(std::ostream& os) {
+    const kociemba engine;
+
+    /* scrambles and facelet-strings, with comments, blank and bad lines in between. */
+    std::vector<std::optional<cube>> expected;
+    std::ostringstream input;
+    input << "# scrambles and states\n";
+    xoshiro256 rng(20);
+    for (int i = 0; i < 24; ++i) {
+        if (i % 2) {
+            const cube c = random_cube(rng);
+            for (color_t col : to_facelets(c))
+            { input << face_letters[std::find(default_scheme.begin(), default_scheme.end(), col) - default_scheme.begin()]; }
+            input << "\n";
+            expected.push_back(c);
+        } else {
+            std::vector<move_t> scramble(25);
+            for (move_t& m : scramble)
+            { m = move_t(rng.below(num_moves)); }
+            cube c = cube::get_solved();
+            apply_sequence(c, scramble);
+            input << format_moves(scramble) << "\n";
+            expected.push_back(c);
+        }
+        if (i == 7) {
+            input << "\n  R U X\n";
+            expected.push_back(std::nullopt);
+        }
+    }
+
+    std::istringstream in(input.str());
+    std::ostringstream out;
+    const batch_report report = solve_batch(engine, in, out, batch_config{ 3, 22, std::chrono::seconds(10) });
+    if (report.states != expected.size() || report.failed != 1 || report.latencies.size() != expected.size() - 1)
+    { os << "solve_batch() reported " << report.states << " states, " << report.failed << " failed\n"; return 1; }
+
+    std::istringstream results(out.str());
+    std::string line;
+    for (std::size_t i = 0; i < expected.size(); ++i) {
+        if (!std::getline(results, line))
+        { os << "solve_batch() wrote " << i << " of " << expected.size() << " lines\n"; return 1; }
+        if (!expected[i]) {
+            if (line != "error: unreadable state")
+            { os << "solve_batch() answered a bad line with \"" << line << "\"\n"; return 1; }
+            continue;
+        }
+        const std::optional<std::vector<move_t>> moves = parse_moves(line);
+        cube c = *expected[i];
+        if (moves)
+        { apply_sequence(c, *moves); }
+        if (!moves || !c.is_solved())
+        { os << "line " << i << " of the output does not solve its input\n"; return 1; }
+    }
+
+    /* with a bidirectional solver: the short scrambles are solved optimally, the rest by two-phase. */
+    const bidirectional short_solver(4);
+    std::istringstream mixed("R U F\nR U R' U' F2 D\n" + input.str().substr(input.str().find('\n') + 1));
+    out.str("");
+    const batch_report mixed_report = solve_batch(engine, mixed, out, batch_config{ 1, 22, std::chrono::seconds(10) }, &short_solver);
+    if (mixed_report.optimal != 2 || !out.str().starts_with("F' U' R'\nD' F2 U R U' R'\n"))
+    { os << "solve_batch() did not solve the short scrambles with the bidirectional solver\n"; return 1; }
+
+    if (parse_state("UUUUUUUUURRRRRRRRRFFFFFFFFFDDDDDDDDDLLLLLLLLLBBBBBBBBB") != cube::get_solved() ||
+        parse_state("R U R' U'") == std::nullopt || parse_state("UUUUUUUUUX") != std::nullopt)
+    { os << "parse_state() does not read scrambles and facelets\n"; return 1; }
+
+    os << "batch_test passed\n";
+    return 0;
+}
+
+#endif
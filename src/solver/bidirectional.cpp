@@ -0,0 +1,303 @@
+#include <groubiks/solver/bidirectional.hpp>
+#include <groubiks/solver/tables.hpp>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/moves.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace {
+
+    using namespace groubiks;
+    using clock_type = std::chrono::steady_clock;
+
+    /* states within 0..6 moves of solved, half-turn-metric. */
+    constexpr std::array<std::size_t, 7> states_within = { 1, 19, 262, 3502, 46741, 621649, 8240087 };
+
+    constexpr int max_solution_length = 20;
+
+}
+
+namespace groubiks::solver {
+
+    /**
+     * @brief open-addressing hash-table (linear probing) of the states near solved.
+     *        an entry is the cube and a byte: its distance << 5 | the move towards solved.
+     *        cube{ 0, 0 } (not a valid cube) marks empty slots.
+     */
+    struct bidirectional_tables {
+        static constexpr std::uint8_t no_move = 0x1f;
+        static constexpr std::size_t npos = ~std::size_t(0);
+
+        int depth;
+        std::size_t size = 0;
+        std::size_t mask;
+        std::vector<cube> keys;
+        std::vector<std::uint8_t> info;
+
+        /**
+         * the forward search is pruned with the distances of three abstractions of the cube,
+         * (ud-slice, twist), (ud-slice, flip) and (twist, flip), the pairs of the phase-1-coordinates of kociemba.hpp.
+         * each one is a lower bound of the distance to solved.
+         */
+        coord_move_table<std::uint16_t> twist_move, flip_move, slice_move;
+        byte_table slice_twist_prune, slice_flip_prune, twist_flip_prune;
+
+        explicit bidirectional_tables(int d)
+            : depth(d), mask(std::bit_ceil(states_within[d] + states_within[d] / 2) - 1),
+              keys(mask + 1, cube{ 0, 0 }), info(mask + 1, 0)
+        {
+            generate_pruning();
+            insert(cube::get_solved(), no_move);
+            std::vector<cube> frontier = { cube::get_solved() };
+            for (int distance = 1; distance <= depth; ++distance) {
+                std::vector<cube> next;
+                for (const cube& c : frontier) {
+                    for (int m = 0; m < num_moves; ++m) {
+                        cube child = c;
+                        apply_move(child, move_t(m));
+                        if (insert(child, std::uint8_t(distance << 5 | int(inverse_move(move_t(m))))))
+                        { next.push_back(child); }
+                    }
+                }
+                frontier = std::move(next);
+            }
+        }
+
+        std::size_t find(const cube& c) const {
+            for (std::size_t i = c.hash() & mask;; i = (i + 1) & mask) {
+                if (keys[i] == c)
+                { return i; }
+                if (keys[i] == cube{ 0, 0 })
+                { return npos; }
+            }
+        }
+
+        /* @returns false if `c` is already in the table. */
+        bool insert(const cube& c, std::uint8_t value) {
+            std::size_t i = c.hash() & mask;
+            for (; keys[i] != cube{ 0, 0 }; i = (i + 1) & mask) {
+                if (keys[i] == c)
+                { return false; }
+            }
+            keys[i] = c;
+            info[i] = value;
+            ++size;
+            return true;
+        }
+
+        void generate_pruning() {
+            std::array<move_t, num_moves> all_moves{};
+            for (int m = 0; m < num_moves; ++m)
+            { all_moves[m] = move_t(m); }
+            twist_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves);
+            flip_move = generate_move_table<std::uint16_t, num_moves>(coord::edge_flip_coord, all_moves);
+            slice_move = generate_move_table<std::uint16_t, num_moves>(coord::ud_slice_coord, all_moves);
+
+            slice_twist_prune = build_pruning_table(std::size_t(coord::num_ud_slices) * coord::num_vertex_twists, num_moves,
+                [this](std::size_t i, int m) {
+                    const std::size_t slice = i / coord::num_vertex_twists, twist = i % coord::num_vertex_twists;
+                    return std::size_t(slice_move.next(coord::coord_t(slice), m)) * coord::num_vertex_twists + twist_move.next(coord::coord_t(twist), m);
+                }, generator_config{ 0, "bidirectional (slice, twist)" });
+            slice_flip_prune = build_pruning_table(std::size_t(coord::num_ud_slices) * coord::num_edge_flips, num_moves,
+                [this](std::size_t i, int m) {
+                    const std::size_t slice = i / coord::num_edge_flips, flip = i % coord::num_edge_flips;
+                    return std::size_t(slice_move.next(coord::coord_t(slice), m)) * coord::num_edge_flips + flip_move.next(coord::coord_t(flip), m);
+                }, generator_config{ 0, "bidirectional (slice, flip)" });
+            twist_flip_prune = build_pruning_table(std::size_t(coord::num_vertex_twists) * coord::num_edge_flips, num_moves,
+                [this](std::size_t i, int m) {
+                    const std::size_t twist = i / coord::num_edge_flips, flip = i % coord::num_edge_flips;
+                    return std::size_t(twist_move.next(coord::coord_t(twist), m)) * coord::num_edge_flips + flip_move.next(coord::coord_t(flip), m);
+                }, generator_config{ 0, "bidirectional (twist, flip)" });
+        }
+
+        int lower_bound(std::size_t twist, std::size_t flip, std::size_t slice) const {
+            return std::max({ int(slice_twist_prune.get(slice * coord::num_vertex_twists + twist)),
+                int(slice_flip_prune.get(slice * coord::num_edge_flips + flip)),
+                int(twist_flip_prune.get(twist * coord::num_edge_flips + flip)) });
+        }
+
+        int distance(std::size_t slot) const { return info[slot] >> 5; }
+
+        /* appends the moves from the state in `slot` to solved. */
+        void append_path(cube c, std::size_t slot, std::vector<move_t>& out) const {
+            while (distance(slot) > 0) {
+                const move_t m = move_t(info[slot] & no_move);
+                out.push_back(m);
+                apply_move(c, m);
+                slot = find(c);
+            }
+        }
+    };
+
+}
+
+namespace {
+
+    /**
+     * @brief the forward half: depth-first over the canonical sequences of length - depth
+     *        moves, looking up the last state of each, pruned by the lower bounds.
+     */
+    class forward_search {
+    public:
+        forward_search(const solver::bidirectional_tables& tables, clock_type::time_point deadline)
+            : m_tables(tables), m_deadline(deadline) {}
+
+        /* searches the solutions of exactly `length` moves. */
+        bool search(const cube& c, int length) {
+            m_path.clear();
+            return expand(c, coord::vertex_twist(c), coord::edge_flip(c), coord::ud_slice(c), length, sequence_start);
+        }
+
+        const std::vector<move_t>& path() const { return m_path; }
+        std::size_t hit() const { return m_hit; }
+        const cube& meeting_state() const { return m_meeting; }
+        bool timed_out() const { return m_timed_out; }
+        std::uint64_t nodes() const { return m_nodes; }
+        std::uint64_t lookups() const { return m_lookups; }
+
+    private:
+        /* `remaining`: moves left to solved, the table covers the last depth of them. */
+        bool expand(const cube& c, std::size_t twist, std::size_t flip, std::size_t slice, int remaining, int state) {
+            ++m_nodes;
+            if (m_tables.lower_bound(twist, flip, slice) > remaining)
+            { return false; }
+            if (remaining == m_tables.depth) {
+                ++m_lookups;
+                m_hit = m_tables.find(c);
+                if (m_hit == solver::bidirectional_tables::npos)
+                { return false; }
+                m_meeting = c;
+                return true;
+            }
+            if ((m_nodes & 0xffff) == 0 && clock_type::now() > m_deadline)
+            { m_timed_out = true; }
+            if (m_timed_out)
+            { return false; }
+            for (std::uint32_t moves = successor_moves[state]; moves; moves &= moves - 1) {
+                const move_t m = move_t(std::countr_zero(moves));
+                cube child = c;
+                apply_move(child, m);
+                m_path.push_back(m);
+                if (expand(child, m_tables.twist_move.next(coord::coord_t(twist), int(m)), m_tables.flip_move.next(coord::coord_t(flip), int(m)),
+                    m_tables.slice_move.next(coord::coord_t(slice), int(m)), remaining - 1, next_sequence_state(m)))
+                { return true; }
+                m_path.pop_back();
+            }
+            return false;
+        }
+
+        const solver::bidirectional_tables& m_tables;
+        clock_type::time_point m_deadline;
+        std::vector<move_t> m_path;
+        std::size_t m_hit = 0;
+        cube m_meeting{ 0, 0 };
+        bool m_timed_out = false;
+        std::uint64_t m_nodes = 0;
+        std::uint64_t m_lookups = 0;
+    };
+
+}
+
+groubiks::solver::bidirectional::bidirectional(int depth)
+    : m_tables(std::make_unique<const bidirectional_tables>(std::clamp(depth, 1, max_depth))) {}
+
+groubiks::solver::bidirectional::~bidirectional() = default;
+
+int groubiks::solver::bidirectional::depth() const
+{ return m_tables->depth; }
+
+std::size_t groubiks::solver::bidirectional::size() const
+{ return m_tables->size; }
+
+std::size_t groubiks::solver::bidirectional::table_bytes() const
+{
+    const bidirectional_tables& t = *m_tables;
+    return t.keys.size() * (sizeof(cube) + 1) + t.slice_twist_prune.bytes() + t.slice_flip_prune.bytes() + t.twist_flip_prune.bytes()
+        + t.twist_move.bytes() + t.flip_move.bytes() + t.slice_move.bytes();
+}
+
+groubiks::solver::solution groubiks::solver::bidirectional::solve(const cube& c, int max_length,
+    std::chrono::milliseconds timeout) const
+{
+    const auto start = clock_type::now();
+    solution res;
+    res.lookups = 1;
+    if (const std::size_t slot = m_tables->find(c); slot != bidirectional_tables::npos) {
+        res.found = m_tables->distance(slot) <= max_length;
+        if (res.found)
+        { m_tables->append_path(c, slot, res.moves); }
+    } else {
+        /* not in the table: at least depth + 1 moves from solved, one forward move per iteration. */
+        forward_search search(*m_tables, start + timeout);
+        max_length = std::min(max_length, max_solution_length);
+        for (int length = m_tables->depth + 1; length <= max_length && !search.timed_out(); ++length) {
+            if (search.search(c, length)) {
+                res.found = true;
+                res.moves = search.path();
+                m_tables->append_path(search.meeting_state(), search.hit(), res.moves);
+                break;
+            }
+        }
+        res.nodes = search.nodes();
+        res.lookups += search.lookups();
+    }
+    res.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file bidirectional.cpp
+ * @brief bidirectional.hpp unit-test.
+ */
+
+#include <groubiks/cube/random.hpp>
+#include <groubiks/solver/optimal.hpp>
+
+int groubiks::solver::bidirectional_test(std::ostream& os) {
+    const bidirectional engine(4);
+    if (engine.size() != states_within[4])
+    { os << "bidirectional(4) holds " << engine.size() << " states instead of " << states_within[4] << "\n"; return 1; }
+
+    /* the solved cube, one inside and one beyond the table. */
+    if (const solution s = engine.solve(cube::get_solved(), 20, std::chrono::seconds(1)); !s.found || s.length() != 0)
+    { os << "bidirectional did not solve the solved cube with 0 moves\n"; return 1; }
+    for (const std::vector<move_t>& scramble : { std::vector{ move_t::R, move_t::U, move_t::Fp },
+        std::vector{ move_t::R, move_t::U, move_t::Rp, move_t::Up, move_t::F2, move_t::D, move_t::L2 } })
+    {
+        cube c = cube::get_solved();
+        apply_sequence(c, scramble);
+        const solution s = engine.solve(c, 20, std::chrono::seconds(10));
+        cube solved = c;
+        apply_sequence(solved, s.moves);
+        if (!s.found || !solved.is_solved() || s.length() != int(scramble.size()))
+        { os << "bidirectional did not find the optimal " << scramble.size() << "-move solution\n"; return 1; }
+        if (engine.solve(c, int(scramble.size()) - 1, std::chrono::seconds(10)).found)
+        { os << "bidirectional found a solution shorter than optimal\n"; return 1; }
+    }
+
+    /* random 8-move scrambles: as long as the solutions of the optimal solver. */
+    const optimal reference(pattern_config{ true, 4, 0, true });
+    xoshiro256 rng(22);
+    for (int i = 0; i < 10; ++i) {
+        cube c = cube::get_solved();
+        for (int k = 0; k < 8; ++k)
+        { apply_move(c, move_t(rng.below(num_moves))); }
+        const solution s = engine.solve(c, 20, std::chrono::seconds(10));
+        const solution expected = reference.solve(c, 20, std::chrono::seconds(10), parallel_config{ 1 });
+        cube solved = c;
+        apply_sequence(solved, s.moves);
+        if (!s.found || !solved.is_solved() || s.length() != expected.length())
+        { os << "bidirectional found " << s.length() << " moves where " << expected.length() << " are optimal\n"; return 1; }
+    }
+
+    os << "bidirectional_test passed\n";
+    return 0;
+}
+
+#endif
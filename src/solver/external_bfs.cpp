@@ -0,0 +1,452 @@
+#include <groubiks/solver/external_bfs.hpp>
+
+#include <bit>
+#include <numeric>
+#include <utility>
+
+/* after all other headers, log.h defines macros like log() and check(). */
+extern "C" {
+    #include <groubiks/utility/log.h>
+}
+
+namespace {
+
+    constexpr std::size_t io_buffer_bytes = std::size_t(1) << 20;
+    constexpr const char* manifest_magic = "groubiks-external-bfs";
+    constexpr int manifest_version = 1;
+
+}
+
+std::uint64_t groubiks::solver::external_bfs_result::states() const
+{ return std::accumulate(histogram.begin(), histogram.end(), std::uint64_t(0)); }
+
+std::ostream& groubiks::solver::operator<<(std::ostream& os, const external_bfs_result& r) {
+    for (std::size_t d = 0; d < r.histogram.size(); ++d)
+    { os << "depth " << d << ": " << r.histogram[d] << "\n"; }
+    return os << r.states() << " states" << (r.complete ? "" : " (incomplete)") << ", "
+              << double(r.bytes_read) / 1e6 << " MB read, " << double(r.bytes_written) / 1e6 << " MB written in "
+              << r.seconds << " s, " << r.megabytes_per_second() << " MB/s\n";
+}
+
+groubiks::solver::rank_writer::rank_writer(const std::filesystem::path& path)
+    : m_out(path, std::ios::binary | std::ios::trunc), m_buffer(io_buffer_bytes) {}
+
+void groubiks::solver::rank_writer::push(std::uint64_t rank) {
+    /* a delta takes at most 10 bytes. */
+    if (m_used + 10 > m_buffer.size())
+    { flush(); }
+    std::uint64_t delta = rank - m_last;
+    m_last = rank;
+    while (delta >= 0x80) {
+        m_buffer[m_used++] = std::uint8_t(delta | 0x80);
+        delta >>= 7;
+    }
+    m_buffer[m_used++] = std::uint8_t(delta);
+    ++m_count;
+}
+
+void groubiks::solver::rank_writer::flush() {
+    m_out.write(reinterpret_cast<const char*>(m_buffer.data()), std::streamsize(m_used));
+    m_bytes += m_used;
+    m_used = 0;
+}
+
+bool groubiks::solver::rank_writer::close() {
+    flush();
+    m_out.close();
+    return !m_out.fail();
+}
+
+groubiks::solver::rank_reader::rank_reader(const std::filesystem::path& path, std::size_t buffer_bytes)
+    : m_in(path, std::ios::binary), m_buffer(buffer_bytes)
+{ m_failed = !m_in.is_open(); }
+
+bool groubiks::solver::rank_reader::refill() {
+    if (m_failed)
+    { return false; }
+    m_in.read(reinterpret_cast<char*>(m_buffer.data()), std::streamsize(m_buffer.size()));
+    m_end = std::size_t(m_in.gcount());
+    m_pos = 0;
+    m_bytes += m_end;
+    if (m_in.bad())
+    { m_failed = true; }
+    return m_end > 0;
+}
+
+groubiks::solver::external_bfs::external_bfs(const external_bfs_config& config)
+    : m_config(config)
+{ m_config.max_merge_runs = std::max(m_config.max_merge_runs, 2); }
+
+std::filesystem::path groubiks::solver::external_bfs::level_path(int depth) const
+{ return m_config.directory / ("level_" + std::to_string(depth) + ".bin"); }
+
+std::filesystem::path groubiks::solver::external_bfs::run_path(int run) const
+{ return m_config.directory / ("run_" + std::to_string(run) + ".bin"); }
+
+bool groubiks::solver::external_bfs::write_manifest() const {
+    const std::filesystem::path path = m_config.directory / "manifest";
+    std::filesystem::path tmp = path;
+    tmp += ".tmp";
+    {
+        std::ofstream out(tmp, std::ios::trunc);
+        out << manifest_magic << ' ' << manifest_version << "\nstart " << m_start
+            << "\ncomplete " << m_result.complete << "\nlevels " << m_result.histogram.size() << "\n";
+        for (std::uint64_t count : m_result.histogram)
+        { out << count << "\n"; }
+        if (!out.flush())
+        { return false; }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    return !ec;
+}
+
+bool groubiks::solver::external_bfs::begin(std::uint64_t start) {
+    m_start = start;
+    m_result = {};
+    m_num_runs = 0;
+    m_first_run = 0;
+    std::error_code ec;
+    std::filesystem::create_directories(m_config.directory, ec);
+    /* runs of an interrupted level. */
+    for (const auto& entry : std::filesystem::directory_iterator(m_config.directory, ec)) {
+        if (entry.path().filename().string().starts_with("run_"))
+        { std::filesystem::remove(entry.path(), ec); }
+    }
+
+    /* resume if the manifest is of the same search and its last two levels are there. */
+    std::ifstream manifest(m_config.directory / "manifest");
+    std::string magic, key;
+    int version = 0;
+    std::uint64_t manifest_start = 0;
+    std::size_t levels = 0;
+    bool complete = false;
+    if (manifest >> magic >> version >> key >> manifest_start && magic == manifest_magic &&
+        version == manifest_version && manifest_start == start &&
+        manifest >> key >> complete >> key >> levels && levels > 0)
+    {
+        std::vector<std::uint64_t> histogram(levels);
+        for (std::uint64_t& count : histogram)
+        { manifest >> count; }
+        const int last = int(levels) - 1;
+        if (manifest && std::filesystem::exists(level_path(last)) && (last == 0 || std::filesystem::exists(level_path(last - 1)))) {
+            m_result.histogram = std::move(histogram);
+            m_result.complete = complete;
+            return true;
+        }
+    }
+
+    rank_writer level0(level_path(0));
+    level0.push(start);
+    m_result.histogram = { 1 };
+    m_result.bytes_written += level0.bytes();
+    if (!level0.close() || !write_manifest()) {
+        m_result.io_error = true;
+        return false;
+    }
+    return true;
+}
+
+namespace {
+
+    /**
+     * @brief lsd-radix-sort over the bits in which the ranks differ (ranks of a coordinate-space
+     *        rarely use more than 30 of them), in as few passes of at most 11 bits as possible.
+     *        several times faster than std::sort on the run-buffers.
+     */
+    void radix_sort(std::vector<std::uint64_t>& data, std::vector<std::uint64_t>& scratch) {
+        std::uint64_t differing = 0;
+        for (std::uint64_t r : data)
+        { differing |= r ^ data[0]; }
+        if (differing == 0)
+        { return; }
+        const int low = std::countr_zero(differing);
+        const int bits = std::bit_width(differing) - low;
+        const int passes = (bits + 10) / 11;
+        const int width = (bits + passes - 1) / passes;
+        const std::uint64_t mask = (std::uint64_t(1) << width) - 1;
+
+        std::vector<std::size_t> counts(std::size_t(passes) << width);
+        for (std::uint64_t r : data) {
+            for (int p = 0; p < passes; ++p)
+            { ++counts[(std::size_t(p) << width) + ((r >> (low + p * width)) & mask)]; }
+        }
+        scratch.resize(data.size());
+        for (int p = 0; p < passes; ++p) {
+            std::size_t* const offsets = counts.data() + (std::size_t(p) << width);
+            std::size_t offset = 0;
+            for (std::uint64_t d = 0; d <= mask; ++d)
+            { offset += std::exchange(offsets[d], offset); }
+            const int shift = low + p * width;
+            for (std::uint64_t r : data)
+            { scratch[offsets[(r >> shift) & mask]++] = r; }
+            data.swap(scratch);
+        }
+    }
+
+}
+
+void groubiks::solver::external_bfs::write_run(std::vector<std::uint64_t>& buffer) {
+    wait_run();
+    if (buffer.empty())
+    { return; }
+    /* the full buffer is sorted and written in the background, the caller fills the other one. */
+    m_writing.swap(buffer);
+    buffer.clear();
+    buffer.reserve(run_capacity());
+    m_writer = std::async(std::launch::async, [this, path = run_path(m_first_run + m_num_runs++)] {
+        radix_sort(m_writing, m_scratch);
+        m_writing.erase(std::unique(m_writing.begin(), m_writing.end()), m_writing.end());
+        rank_writer run(path);
+        for (std::uint64_t rank : m_writing)
+        { run.push(rank); }
+        run_written res;
+        res.error = !run.close();
+        res.bytes = run.bytes();
+        return res;
+    });
+}
+
+void groubiks::solver::external_bfs::wait_run() {
+    if (!m_writer.valid())
+    { return; }
+    const run_written res = m_writer.get();
+    m_result.io_error |= res.error;
+    m_result.bytes_written += res.bytes;
+}
+
+namespace {
+
+    /**
+     * @brief a tournament-tree of losers over sorted readers: every inner node keeps the loser
+     *        of the match played there, so the next smallest rank costs one comparison per
+     *        level on the path of the last winner, instead of the pop and push of a heap.
+     */
+    class loser_tree {
+    public:
+        explicit loser_tree(std::vector<groubiks::solver::rank_reader>& inputs)
+            : m_inputs(inputs), m_size(std::bit_ceil(std::max<std::size_t>(inputs.size(), 1))),
+              m_ranks(m_size), m_done(m_size, true), m_losers(m_size)
+        {
+            for (std::size_t i = 0; i < inputs.size(); ++i)
+            { m_done[i] = !inputs[i].next(m_ranks[i]); }
+            std::vector<std::size_t> winners(2 * m_size);
+            for (std::size_t i = 0; i < m_size; ++i)
+            { winners[m_size + i] = i; }
+            for (std::size_t node = m_size - 1; node > 0; --node) {
+                const std::size_t a = winners[2 * node], b = winners[2 * node + 1];
+                winners[node] = less(a, b) ? a : b;
+                m_losers[node] = less(a, b) ? b : a;
+            }
+            m_winner = winners[1];
+        }
+
+        bool empty() const { return m_done[m_winner]; }
+        std::uint64_t top() const { return m_ranks[m_winner]; }
+
+        /* advances the reader of top() and replays its matches up to the root. */
+        void pop() {
+            std::size_t w = m_winner;
+            m_done[w] = !m_inputs[w].next(m_ranks[w]);
+            for (std::size_t node = (m_size + w) / 2; node > 0; node /= 2) {
+                if (less(m_losers[node], w))
+                { std::swap(m_losers[node], w); }
+            }
+            m_winner = w;
+        }
+
+    private:
+        /* exhausted readers lose every match. */
+        bool less(std::size_t a, std::size_t b) const
+        { return !m_done[a] && (m_done[b] || m_ranks[a] < m_ranks[b]); }
+
+        std::vector<groubiks::solver::rank_reader>& m_inputs;
+        std::size_t m_size;
+        std::vector<std::uint64_t> m_ranks;
+        std::vector<std::uint8_t> m_done;
+        std::vector<std::size_t> m_losers;
+        std::size_t m_winner = 0;
+    };
+
+    /**
+     * @brief merges the sorted `inputs` without duplicates, leaving out everything in `exclude`
+     *        (sorted too), into `out`. the excluded readers are merged into one ascending stream
+     *        as well, so every rank is checked against a single current rank.
+     * @returns the bytes read.
+     */
+    std::uint64_t merge_runs(std::vector<groubiks::solver::rank_reader>& inputs,
+        std::vector<groubiks::solver::rank_reader>& exclude, groubiks::solver::rank_writer& out)
+    {
+        loser_tree tree(inputs), excluded(exclude);
+        bool any = false;
+        std::uint64_t last = 0;
+        for (; !tree.empty(); tree.pop()) {
+            const std::uint64_t rank = tree.top();
+            if (any && rank == last)
+            { continue; }
+            any = true;
+            last = rank;
+            while (!excluded.empty() && excluded.top() < rank)
+            { excluded.pop(); }
+            if (excluded.empty() || excluded.top() != rank)
+            { out.push(rank); }
+        }
+
+        std::uint64_t bytes = 0;
+        for (const auto& r : inputs)
+        { bytes += r.bytes(); }
+        for (const auto& r : exclude)
+        { bytes += r.bytes(); }
+        return bytes;
+    }
+
+    bool any_failed(const std::vector<groubiks::solver::rank_reader>& readers) {
+        return std::any_of(readers.begin(), readers.end(), [](const auto& r) { return r.failed(); });
+    }
+
+}
+
+void groubiks::solver::external_bfs::finish_level() {
+    const auto start = clock_type::now();
+    wait_run();
+    const std::size_t buffer_bytes = std::max<std::size_t>(4096,
+        std::min(io_buffer_bytes, m_config.memory_bytes / std::size_t(m_config.max_merge_runs + 2)));
+    std::error_code ec;
+
+    /* too many runs to merge at once: merge the oldest ones into a new run first. */
+    while (m_num_runs > m_config.max_merge_runs && !m_result.io_error) {
+        std::vector<rank_reader> inputs, none;
+        for (int r = 0; r < m_config.max_merge_runs; ++r)
+        { inputs.emplace_back(run_path(m_first_run + r), buffer_bytes); }
+        rank_writer merged(run_path(m_first_run + m_num_runs));
+        m_result.bytes_read += merge_runs(inputs, none, merged);
+        m_result.io_error |= !merged.close() || any_failed(inputs);
+        m_result.bytes_written += merged.bytes();
+        for (int r = 0; r < m_config.max_merge_runs; ++r)
+        { std::filesystem::remove(run_path(m_first_run + r), ec); }
+        m_first_run += m_config.max_merge_runs;
+        m_num_runs -= m_config.max_merge_runs - 1;
+    }
+
+    /* the last merge leaves out the two previous levels. */
+    const int d = depth();
+    std::vector<rank_reader> inputs, previous;
+    for (int r = 0; r < m_num_runs; ++r)
+    { inputs.emplace_back(run_path(m_first_run + r), buffer_bytes); }
+    previous.emplace_back(level_path(d), buffer_bytes);
+    if (d > 0)
+    { previous.emplace_back(level_path(d - 1), buffer_bytes); }
+    rank_writer next(level_path(d + 1));
+    m_result.bytes_read += merge_runs(inputs, previous, next);
+    m_result.io_error |= !next.close() || any_failed(inputs) || any_failed(previous);
+    m_result.bytes_written += next.bytes();
+    for (int r = 0; r < m_num_runs; ++r)
+    { std::filesystem::remove(run_path(m_first_run + r), ec); }
+    m_first_run = 0;
+    m_num_runs = 0;
+    if (m_result.io_error)
+    { return; }
+
+    if (next.count() == 0) {
+        std::filesystem::remove(level_path(d + 1), ec);
+        m_result.complete = true;
+    } else {
+        m_result.histogram.push_back(next.count());
+    }
+    m_result.io_error |= !write_manifest();
+    /* the next level only needs the last two. */
+    if (!m_result.complete && d > 0)
+    { std::filesystem::remove(level_path(d - 1), ec); }
+
+    if (m_config.name != nullptr && log_initialized()) {
+        logf_info("%s: depth %d, %llu states, %.3f s", m_config.name, d + 1,
+            (unsigned long long)next.count(), std::chrono::duration<double>(clock_type::now() - start).count());
+    }
+}
+
+groubiks::solver::external_bfs_result groubiks::solver::external_bfs::finish(clock_type::time_point begin_time) {
+    m_result.seconds = std::chrono::duration<double>(clock_type::now() - begin_time).count();
+    return m_result;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file external_bfs.cpp
+ * @brief external_bfs.hpp unit-test.
+ */
+
+#include <array>
+#include <unordered_map>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/solver/tables.hpp>
+
+int groubiks::solver::external_bfs_test(std::ostream& os) {
+    /* rank-files round-trip, with deltas of every length. */
+    const std::filesystem::path dir = std::filesystem::temp_directory_path() / "groubiks_external_bfs_test";
+    std::error_code ec;
+    std::filesystem::remove_all(dir, ec);
+    std::filesystem::create_directories(dir, ec);
+    {
+        const std::vector<std::uint64_t> ranks = { 0, 1, 127, 128, 300, 1 << 20, std::uint64_t(1) << 40, ~std::uint64_t(0) };
+        rank_writer writer(dir / "ranks");
+        for (std::uint64_t r : ranks)
+        { writer.push(r); }
+        if (!writer.close())
+        { os << "rank_writer could not write " << (dir / "ranks") << "\n"; return 1; }
+        rank_reader reader(dir / "ranks", 16);
+        std::vector<std::uint64_t> read;
+        for (std::uint64_t r; reader.next(r);)
+        { read.push_back(r); }
+        if (read != ranks || reader.failed())
+        { os << "rank_reader does not read what rank_writer wrote\n"; return 1; }
+    }
+
+    /* the corners of the 2x2 under <U, R>: 29160 states, ranked sparsely by perm * 2187 + twist. */
+    const std::array<move_t, 6> moves = { move_t::U, move_t::U2, move_t::Up, move_t::R, move_t::R2, move_t::Rp };
+    const std::vector<std::uint16_t> perm_moves = build_move_table<std::uint16_t>(coord::num_vertex_perms, moves,
+        coord::set_vertex_perm, coord::vertex_perm);
+    const std::vector<std::uint16_t> twist_moves = build_move_table<std::uint16_t>(coord::num_vertex_twists, moves,
+        coord::set_vertex_twist, coord::vertex_twist);
+    auto expand = [&](std::uint64_t rank, auto&& visit) {
+        const std::uint64_t perm = rank / coord::num_vertex_twists, twist = rank % coord::num_vertex_twists;
+        for (std::size_t m = 0; m < moves.size(); ++m)
+        { visit(std::uint64_t(perm_moves[perm * moves.size() + m]) * coord::num_vertex_twists + twist_moves[twist * moves.size() + m]); }
+    };
+
+    /* the same search in memory. */
+    std::unordered_map<std::uint64_t, int> distance = { { 0, 0 } };
+    std::vector<std::uint64_t> frontier = { 0 }, expected = { 1 };
+    while (!frontier.empty()) {
+        std::vector<std::uint64_t> next;
+        for (std::uint64_t rank : frontier) {
+            expand(rank, [&](std::uint64_t n) {
+                if (distance.emplace(n, int(expected.size())).second)
+                { next.push_back(n); }
+            });
+        }
+        if (!next.empty())
+        { expected.push_back(next.size()); }
+        frontier = std::move(next);
+    }
+
+    /* tiny runs, merged in several passes, and a search interrupted after 4 levels. */
+    external_bfs_config config{ dir / "bfs", 8192 * sizeof(std::uint64_t), 3, 4 };
+    const external_bfs_result partial = external_bfs(config).run(0, expand);
+    if (partial.complete || partial.histogram != std::vector<std::uint64_t>(expected.begin(), expected.begin() + 5))
+    { os << "external_bfs stopped after 4 levels with the wrong histogram:\n" << partial; return 1; }
+    config.max_depth = 64;
+    const external_bfs_result resumed = external_bfs(config).run(0, expand);
+    if (!resumed.complete || resumed.io_error || resumed.histogram != expected || resumed.states() != 29160)
+    { os << "external_bfs resumed with the wrong histogram:\n" << resumed; return 1; }
+    /* resuming a complete search reads nothing. */
+    const external_bfs_result again = external_bfs(config).run(0, expand);
+    if (!again.complete || again.histogram != expected || again.bytes_read != 0)
+    { os << "external_bfs searched a complete directory again\n"; return 1; }
+
+    std::filesystem::remove_all(dir, ec);
+    os << "external_bfs_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,487 @@
+#include <groubiks/solver/kociemba.hpp>
+#include <groubiks/solver/tables.hpp>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/symmetry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+namespace {
+
+    using namespace groubiks;
+    using coord::coord_t;
+    using clock_type = std::chrono::steady_clock;
+
+    /* the moves of phase 2, i.e. the generators of G1. */
+    constexpr std::array<move_t, 10> phase2_moves = {
+        move_t::U, move_t::U2, move_t::Up, move_t::D, move_t::D2, move_t::Dp,
+        move_t::R2, move_t::L2, move_t::F2, move_t::B2
+    };
+    constexpr int num_phase2_moves = int(phase2_moves.size());
+
+    constexpr bool is_phase2_move(move_t m) {
+        const face_t f = move_face(m);
+        return f == face_t::U || f == face_t::D || move_power(m) == 2;
+    }
+
+    /* successor_moves as indices into phase2_moves. */
+    constexpr std::array<std::uint32_t, num_sequence_states> phase2_successors = [] {
+        std::array<std::uint32_t, num_sequence_states> res{};
+        for (int state = 0; state < num_sequence_states; ++state) {
+            for (int i = 0; i < num_phase2_moves; ++i) {
+                if (successor_moves[state] >> std::uint8_t(phase2_moves[i]) & 1)
+                { res[state] |= std::uint32_t(1) << i; }
+            }
+        }
+        return res;
+    }();
+
+    constexpr int max_solution_length = 31;
+
+    /* (ud-slice, edge-flip) as slice * num_edge_flips + flip, and its classes under the 16 U-D-symmetries. */
+    constexpr std::size_t num_flipslices = std::size_t(coord::num_ud_slices) * coord::num_edge_flips;
+    constexpr std::size_t num_flipslice_classes = 64430;
+    constexpr std::size_t num_flipslice_twist_entries = num_flipslice_classes * coord::num_vertex_twists;
+
+    /*
+     * the 120-degree rotation of the whole cube around the URF-DBL-diagonal (symmetry.hpp).
+     * conjugating a cube with it moves the U/D-axis of phase 1 to the R/L- and F/B-axes,
+     * which gives the search three different problems for the same cube.
+     * a move m' on the conjugated cube is the move conjugate_move(m', urf3_inverse) on the original cube.
+     */
+    constexpr int urf3 = 16;
+    constexpr int urf3_inverse = inverse_symmetry(urf3);
+
+}
+
+namespace groubiks::solver {
+
+    struct kociemba_tables {
+        /* phase 1: [coord * num_moves + move] */
+        coord_move_table<std::uint16_t> twist_move;
+        coord_move_table<std::uint16_t> flip_move;
+        coord_move_table<std::uint16_t> slice_move;
+        /* phase 2: [coord * num_phase2_moves + phase-2-move], vertex_perm for all 18 moves */
+        coord_move_table<std::uint16_t> vertex_perm_move;
+        coord_move_table<std::uint16_t, num_phase2_moves> ud_edge_move;
+        coord_move_table<std::uint8_t, num_phase2_moves> slice_perm_move;
+        /* replays a phase-1-solution on the single edges, for the phase-2-coordinates at its end. */
+        coord_move_table<std::uint8_t> edge_move;
+        /*
+         * phase-1-pruning: the exact phase-1-distance, indexed by (class of the flipslice, twist),
+         * the twist conjugated by the symmetry that turns the flipslice into the representative of its class.
+         */
+        flat_table<std::uint16_t> flipslice_class;
+        flat_table<std::uint8_t> flipslice_symmetry;
+        /* [twist * num_ud_symmetries + s] */
+        flat_table<std::uint16_t> twist_conjugation;
+        nibble_table flipslice_twist_prune;
+        /* phase-2-pruning: [slice-perm * num_vertex_perms + vertex-perm] etc. */
+        byte_table slice_vertex_prune;
+        byte_table slice_edge_prune;
+        /* set if the tables above point into a mapped table-file. */
+        std::optional<table_file> file;
+
+        void generate();
+
+        std::size_t flipslice_twist_index(coord_t slice, coord_t flip, coord_t twist) const {
+            const std::size_t flipslice = std::size_t(slice) * coord::num_edge_flips + flip;
+            return std::size_t(flipslice_class[flipslice]) * coord::num_vertex_twists
+                + twist_conjugation[std::size_t(twist) * num_ud_symmetries + flipslice_symmetry[flipslice]];
+        }
+
+        template<class Fn>
+        void for_each_table(Fn&& fn) {
+            fn("twist_move", twist_move, std::size_t(coord::num_vertex_twists) * num_moves);
+            fn("flip_move", flip_move, std::size_t(coord::num_edge_flips) * num_moves);
+            fn("slice_move", slice_move, std::size_t(coord::num_ud_slices) * num_moves);
+            fn("vertex_perm_move", vertex_perm_move, std::size_t(coord::num_vertex_perms) * num_moves);
+            fn("ud_edge_move", ud_edge_move, std::size_t(coord::num_ud_edge_perms) * num_phase2_moves);
+            fn("slice_perm_move", slice_perm_move, std::size_t(coord::num_slice_perms) * num_phase2_moves);
+            fn("edge_position_move", edge_move, std::size_t(coord::num_edge_positions) * num_moves);
+            fn("flipslice_class", flipslice_class, num_flipslices);
+            fn("flipslice_symmetry", flipslice_symmetry, num_flipslices);
+            fn("twist_conjugation", twist_conjugation, std::size_t(coord::num_vertex_twists) * num_ud_symmetries);
+            fn("flipslice_twist_prune", flipslice_twist_prune, num_flipslice_twist_entries);
+            fn("slice_vertex_prune", slice_vertex_prune, std::size_t(coord::num_slice_perms) * coord::num_vertex_perms);
+            fn("slice_edge_prune", slice_edge_prune, std::size_t(coord::num_slice_perms) * coord::num_ud_edge_perms);
+        }
+    };
+
+    void kociemba_tables::generate() {
+        std::array<move_t, num_moves> all_moves{};
+        for (int m = 0; m < num_moves; ++m)
+        { all_moves[m] = move_t(m); }
+
+        twist_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves);
+        flip_move = generate_move_table<std::uint16_t, num_moves>(coord::edge_flip_coord, all_moves);
+        slice_move = generate_move_table<std::uint16_t, num_moves>(coord::ud_slice_coord, all_moves);
+        vertex_perm_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_perm_coord, all_moves);
+        ud_edge_move = generate_move_table<std::uint16_t, num_phase2_moves>(coord::ud_edge_perm_coord, phase2_moves);
+        slice_perm_move = generate_move_table<std::uint8_t, num_phase2_moves>(coord::slice_perm_coord, phase2_moves);
+        edge_move = generate_move_table<std::uint8_t, num_moves>(coord::edge_position_coord, all_moves);
+
+        /*
+         * the flip of a conjugate depends on the slice as well (a quarter turn of the whole cube
+         * around U-D swaps the roles of the F-B- and R-L-axes), so only the flipslice has classes.
+         */
+        symmetry_classes classes = build_symmetry_classes_by(coord_t(num_flipslices), num_ud_symmetries, [](coord_t fs, int s) {
+            cube c = cube::get_solved();
+            coord::set_ud_slice(c, fs / coord::num_edge_flips);
+            coord::set_edge_flip(c, fs % coord::num_edge_flips);
+            const cube conjugated = conjugate(c, s);
+            return coord::ud_slice(conjugated) * coord::num_edge_flips + coord::edge_flip(conjugated);
+        });
+        flipslice_class = flat_table(std::move(classes.class_of));
+        flipslice_symmetry = flat_table(std::move(classes.symmetry_of));
+        twist_conjugation = flat_table(build_conjugation_table<std::uint16_t>(coord::num_vertex_twists,
+            num_ud_symmetries, coord::set_vertex_twist, coord::vertex_twist));
+        /* a neighbour with a symmetric representative is visited with all twists it can be conjugated to, as in optimal.cpp. */
+        flipslice_twist_prune = build_nibble_table(num_flipslice_twist_entries, [&](std::size_t i, auto&& visit) {
+            const coord_t rep = classes.representatives[i / coord::num_vertex_twists];
+            const coord_t slice = rep / coord::num_edge_flips, flip = rep % coord::num_edge_flips;
+            const coord_t twist = coord_t(i % coord::num_vertex_twists);
+            for (int m = 0; m < num_moves; ++m) {
+                const std::size_t next = flipslice_twist_index(slice_move.next(slice, m), flip_move.next(flip, m), twist_move.next(twist, m));
+                if (visit(next))
+                { return; }
+                const std::size_t next_row = next / coord::num_vertex_twists, next_twist = next % coord::num_vertex_twists;
+                for (std::uint64_t syms = classes.stabilizers[next_row] & ~std::uint64_t(1); syms != 0; syms &= syms - 1) {
+                    const int s = std::countr_zero(syms);
+                    if (visit(next_row * coord::num_vertex_twists + twist_conjugation[next_twist * num_ud_symmetries + s]))
+                    { return; }
+                }
+            }
+        }, generator_config{ 0, "kociemba (flipslice-class, twist)" });
+
+        slice_vertex_prune = build_pruning_table(std::size_t(coord::num_slice_perms) * coord::num_vertex_perms, num_phase2_moves,
+            [this](std::size_t i, int m) {
+                const std::size_t slice = i / coord::num_vertex_perms, perm = i % coord::num_vertex_perms;
+                return std::size_t(slice_perm_move.next(coord_t(slice), m)) * coord::num_vertex_perms
+                    + vertex_perm_move.next(coord_t(perm), std::uint8_t(phase2_moves[m]));
+            }, generator_config{ 0, "kociemba (slice-perm, vertex-perm)" });
+        slice_edge_prune = build_pruning_table(std::size_t(coord::num_slice_perms) * coord::num_ud_edge_perms, num_phase2_moves,
+            [this](std::size_t i, int m) {
+                const std::size_t slice = i / coord::num_ud_edge_perms, perm = i % coord::num_ud_edge_perms;
+                return std::size_t(slice_perm_move.next(coord_t(slice), m)) * coord::num_ud_edge_perms
+                    + ud_edge_move.next(coord_t(perm), m);
+            }, generator_config{ 0, "kociemba (slice-perm, ud-edge-perm)" });
+    }
+
+}
+
+namespace {
+
+    using groubiks::solver::kociemba_tables;
+
+    /**
+     * @brief state of a single solve-call.
+     * @details six variants of the cube are searched alternately, one phase-1 depth at a time:
+     *          the cube rotated onto each of the three axes, and the inverse of each.
+     *          a solution P of an inverse turns into the solution P^-1, moves of a rotated
+     *          cube are rotated back with conjugate_move(). the variants usually hit short
+     *          solutions at very different times, so this finds short solutions much earlier.
+     */
+    class two_phase_search {
+    public:
+        two_phase_search(const kociemba_tables& tables, const cube& c, int max_length, clock_type::time_point deadline)
+            : m_tables(tables), m_max_length(max_length), m_deadline(deadline)
+        {
+            cube rotated = c;
+            for (int axis = 0; axis < 3; ++axis) {
+                m_cubes[2 * axis] = rotated;
+                m_cubes[2 * axis + 1] = inverse(rotated);
+                rotated = conjugate(rotated, urf3);
+            }
+            for (int side = 0; side < num_sides; ++side) {
+                m_vertex_perms[side] = coord::vertex_perm(m_cubes[side]);
+                for (int e = 0; e < cube::num_edges; ++e)
+                { m_edge_positions[side][e] = std::uint8_t(coord::edge_position(m_cubes[side], e)); }
+            }
+        }
+
+        void run() {
+            coord_t twist[num_sides], flip[num_sides], slice[num_sides];
+            int depth = max_solution_length;
+            for (int side = 0; side < num_sides; ++side) {
+                twist[side] = coord::vertex_twist(m_cubes[side]);
+                flip[side] = coord::edge_flip(m_cubes[side]);
+                slice[side] = coord::ud_slice(m_cubes[side]);
+                depth = std::min(depth, phase1_bound(twist[side], flip[side], slice[side]));
+            }
+            for (; depth < m_best_length && !m_done; ++depth) {
+                for (m_side = 0; m_side < num_sides && depth < m_best_length && !m_done; ++m_side) {
+                    m_replay_vertices[0] = m_vertex_perms[m_side];
+                    m_replay_edges[0] = m_edge_positions[m_side];
+                    m_replayed = 0;
+                    phase1(twist[m_side], flip[m_side], slice[m_side], 0, depth, sequence_start);
+                }
+            }
+        }
+
+        std::vector<move_t> best() const
+        { return std::vector<move_t>(m_best.begin(), m_best.begin() + m_best_length); }
+        bool found() const { return m_best_length <= m_max_length; }
+        bool any() const { return m_best_length < max_solution_length + 1; }
+        std::uint64_t nodes() const { return m_nodes; }
+
+    private:
+        int phase1_bound(coord_t twist, coord_t flip, coord_t slice) const
+        { return m_tables.flipslice_twist_prune.get(m_tables.flipslice_twist_index(slice, flip, twist)); }
+
+        int phase2_bound(coord_t vertices, coord_t edges, coord_t slice) const {
+            const int a = m_tables.slice_vertex_prune.get(slice * coord::num_vertex_perms + vertices);
+            const int b = m_tables.slice_edge_prune.get(slice * coord::num_ud_edge_perms + edges);
+            return a > b ? a : b;
+        }
+
+        bool expired() {
+            if ((++m_nodes & 0x3ff) == 0 && clock_type::now() > m_deadline)
+            { m_done = true; }
+            return m_done;
+        }
+
+        void phase1(coord_t twist, coord_t flip, coord_t slice, int depth, int togo, int state) {
+            if (expired())
+            { return; }
+            if (togo == 0) {
+                /* ending phase 1 with a G1-move means a shorter phase-1 solution was already tried. */
+                if (twist == 0 && flip == 0 && slice == 0 &&
+                    (depth == 0 || !is_phase2_move(m_path[depth - 1])))
+                { start_phase2(depth); }
+                return;
+            }
+            /*
+             * leaving G1 and returning to it takes at least 5 moves, so from within G1 the
+             * remaining moves of a shorter phase 1 would all be G1-moves, see above.
+             */
+            if (togo < 5 && twist == 0 && flip == 0 && slice == 0)
+            { return; }
+            struct child { coord_t twist, flip, slice; std::size_t index; };
+            std::array<child, num_moves> children;
+            for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+                const int m = std::countr_zero(moves);
+                child& c = children[m];
+                c.twist = m_tables.twist_move.next(twist, m);
+                c.flip = m_tables.flip_move.next(flip, m);
+                c.slice = m_tables.slice_move.next(slice, m);
+                const std::size_t fs = std::size_t(c.slice) * coord::num_edge_flips + c.flip;
+                __builtin_prefetch(&m_tables.flipslice_class[fs]);
+                __builtin_prefetch(&m_tables.flipslice_symmetry[fs]);
+            }
+            for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+                child& c = children[std::countr_zero(moves)];
+                c.index = m_tables.flipslice_twist_index(c.slice, c.flip, c.twist);
+                __builtin_prefetch(m_tables.flipslice_twist_prune.raw().data() + (c.index >> 1));
+            }
+            for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+                const int m = std::countr_zero(moves);
+                const child& c = children[m];
+                if (m_tables.flipslice_twist_prune.get(c.index) >= togo)
+                { continue; }
+                m_path[depth] = move_t(m);
+                m_replayed = std::min(m_replayed, depth);
+                phase1(c.twist, c.flip, c.slice, depth + 1, togo - 1, next_sequence_state(move_t(m)));
+                if (m_done)
+                { return; }
+            }
+        }
+
+        /*
+         * the phase-2-coordinates after the phase-1-solution, replayed on the coordinates of the side.
+         * consecutive phase-1-solutions share most of their moves, so only the moves after
+         * the common prefix with the last replay are replayed again.
+         */
+        void start_phase2(int depth1) {
+            for (; m_replayed < depth1; ++m_replayed) {
+                const int m = std::uint8_t(m_path[m_replayed]);
+                m_replay_vertices[m_replayed + 1] = m_tables.vertex_perm_move.next(m_replay_vertices[m_replayed], m);
+                for (int e = 0; e < cube::num_edges; ++e)
+                { m_replay_edges[m_replayed + 1][e] = std::uint8_t(m_tables.edge_move.next(m_replay_edges[m_replayed][e], m)); }
+            }
+            const coord_t vertices = m_replay_vertices[depth1];
+            std::array<std::uint8_t, cube::num_edges> in_slot{};
+            for (int e = 0; e < cube::num_edges; ++e)
+            { in_slot[m_replay_edges[depth1][e] / 2] = std::uint8_t(e); }
+            /* most phase-1-solutions are already too long by the (slice-perm, vertex-perm)-table. */
+            const int limit = m_best_length - 1 - depth1;
+            const coord_t slice = coord::detail::rank_perm<4>([&](int i) { return in_slot[8 + i] - 8; });
+            if (m_tables.slice_vertex_prune.get(slice * coord::num_vertex_perms + vertices) > limit)
+            { return; }
+            const coord_t edges = coord::detail::rank_perm<8>([&](int i) { return in_slot[i]; });
+            const int state = depth1 > 0 ? next_sequence_state(m_path[depth1 - 1]) : sequence_start;
+            for (int depth2 = phase2_bound(vertices, edges, slice); depth2 <= limit && !m_done; ++depth2) {
+                if (phase2(vertices, edges, slice, depth1, depth2, state)) {
+                    store_best(depth1 + depth2);
+                    if (found())
+                    { m_done = true; }
+                    return;
+                }
+            }
+        }
+
+        void store_best(int length) {
+            m_best_length = length;
+            for (int i = 0; i < length; ++i) {
+                move_t m = m_side % 2 == 0 ? m_path[i] : inverse_move(m_path[length - 1 - i]);
+                for (int axis = 0; axis < m_side / 2; ++axis)
+                { m = conjugate_move(m, urf3_inverse); }
+                m_best[i] = m;
+            }
+        }
+
+        bool phase2(coord_t vertices, coord_t edges, coord_t slice, int depth, int togo, int state) {
+            if (togo == 0)
+            { return vertices == 0 && edges == 0 && slice == 0; }
+            if (expired())
+            { return false; }
+            for (std::uint32_t moves = phase2_successors[state]; moves != 0; moves &= moves - 1) {
+                const int i = std::countr_zero(moves);
+                const int m = std::uint8_t(phase2_moves[i]);
+                const coord_t v = m_tables.vertex_perm_move.next(vertices, m);
+                const coord_t e = m_tables.ud_edge_move.next(edges, i);
+                const coord_t s = m_tables.slice_perm_move.next(slice, i);
+                if (phase2_bound(v, e, s) >= togo)
+                { continue; }
+                m_path[depth] = move_t(m);
+                if (phase2(v, e, s, depth + 1, togo - 1, next_sequence_state(move_t(m))))
+                { return true; }
+            }
+            return false;
+        }
+
+        static constexpr int num_sides = 6;
+
+        const kociemba_tables& m_tables;
+        cube m_cubes[num_sides];
+        coord_t m_vertex_perms[num_sides];
+        std::array<std::uint8_t, cube::num_edges> m_edge_positions[num_sides];
+        const int m_max_length;
+        const clock_type::time_point m_deadline;
+
+        std::array<move_t, max_solution_length + 1> m_path{};
+        std::array<move_t, max_solution_length + 1> m_best{};
+        /* the phase-2-coordinates after the first i moves of m_path, up to i = m_replayed. */
+        coord_t m_replay_vertices[max_solution_length + 1];
+        std::array<std::uint8_t, cube::num_edges> m_replay_edges[max_solution_length + 1];
+        int m_replayed = 0;
+        int m_best_length = max_solution_length + 1;
+        std::uint64_t m_nodes = 0;
+        int m_side = 0;
+        bool m_done = false;
+    };
+
+}
+
+groubiks::solver::kociemba::kociemba() {
+    auto tables = std::make_unique<kociemba_tables>();
+    tables->generate();
+    m_tables = std::move(tables);
+}
+
+groubiks::solver::kociemba::kociemba(const std::filesystem::path& table_path, bool verify) {
+    auto tables = std::make_unique<kociemba_tables>();
+    load_or_generate(*tables, table_path, verify);
+    m_tables = std::move(tables);
+}
+
+groubiks::solver::kociemba::~kociemba() = default;
+
+groubiks::solver::solution groubiks::solver::kociemba::solve(const cube& c, int max_length, std::chrono::milliseconds timeout) const {
+    const auto start = clock_type::now();
+    two_phase_search search(*m_tables, c, max_length, start + timeout);
+    search.run();
+
+    solution res;
+    res.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    res.nodes = search.nodes();
+    res.found = search.found();
+    if (search.any())
+    { res.moves = search.best(); }
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file kociemba.cpp
+ * @brief kociemba.hpp unit-test.
+ */
+
+int groubiks::solver::kociemba_test(std::ostream& os) {
+    /* the first solver generates and writes the table-file, the tables below map it. */
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "groubiks_kociemba_test.tables";
+    std::filesystem::remove(path);
+    const kociemba solver(path);
+    kociemba_tables tables;
+    if (!load_or_generate(tables, path, true))
+    { os << "the table-file was not written\n"; return 1; }
+
+    if (!solver.solve(cube::get_solved(), 0, std::chrono::milliseconds(100)).found)
+    { os << "the solved cube has no empty solution\n"; return 1; }
+
+    std::uint64_t state = 0x5851f42d4c957f2dull;
+    auto scramble = [&](int length) {
+        cube c = cube::get_solved();
+        for (int i = 0; i < length; ++i) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            apply_move(c, move_t(state % num_moves));
+        }
+        return c;
+    };
+
+    /*
+     * the symmetry-reduced table holds the exact phase-1-distance: 0 exactly in G1, and otherwise
+     * one more than the closest neighbour. it is the same for all conjugates that keep the U-D-axis.
+     */
+    auto distance = [&](const cube& x)
+    { return tables.flipslice_twist_prune.get(tables.flipslice_twist_index(coord::ud_slice(x), coord::edge_flip(x), coord::vertex_twist(x))); };
+    for (int k = 0; k < 200; ++k) {
+        const int length = k % 14;
+        const cube c = scramble(length);
+        const int d = distance(c);
+        const bool in_g1 = coord::vertex_twist(c) == 0 && coord::edge_flip(c) == 0 && coord::ud_slice(c) == 0;
+        int closest = d + 1;
+        for (int m = 0; m < num_moves; ++m) {
+            cube next = c;
+            apply_move(next, move_t(m));
+            closest = std::min(closest, int(distance(next)));
+            if (distance(next) + 1 < d || distance(next) > d + 1)
+            { closest = -1; break; }
+        }
+        if (d > length || (d == 0) != in_g1 || (d > 0 && closest != d - 1))
+        { os << "phase-1-distance " << d << " of a cube " << length << " moves from solved is wrong\n"; return 1; }
+        for (int s = 1; s < num_ud_symmetries; ++s) {
+            if (distance(conjugate(c, s)) != d)
+            { os << "phase-1-distance changes under symmetry " << s << '\n'; return 1; }
+        }
+    }
+
+    /* a few random states need seconds for 19 moves, within the budget all get at most 20. */
+    double total_seconds = 0.0;
+    int total_length = 0, num_found = 0;
+    constexpr int num_cubes = 20;
+    for (int k = 0; k < num_cubes; ++k) {
+        cube c = scramble(40);
+        const solution s = solver.solve(c, 19, std::chrono::milliseconds(500));
+        apply_sequence(c, s.moves);
+        if (s.length() > 20 || !c.is_solved())
+        { os << "no valid solution within 20 moves for cube " << k << '\n'; return 1; }
+        total_seconds += s.seconds;
+        total_length += s.length();
+        num_found += s.found;
+    }
+    os << num_found << " of " << num_cubes << " within 19 moves, average length " << double(total_length) / num_cubes
+       << ", average time " << total_seconds / num_cubes * 1e3 << " ms\n";
+    std::filesystem::remove(path);
+
+    os << "kociemba_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,259 @@
+#include <groubiks/solver/last_layer.hpp>
+
+#include <algorithm>
+#include <array>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/notation.hpp>
+#include <groubiks/cube/symmetry.hpp>
+
+namespace {
+
+    using namespace groubiks;
+
+    /* U^k as a cube, k = 0..3. */
+    constexpr std::array<cube, 4> auf_cubes = {
+        cube::get_solved(), move_cubes[std::uint8_t(move_t::U)], move_cubes[std::uint8_t(move_t::U2)], move_cubes[std::uint8_t(move_t::Up)]
+    };
+
+    /* the symmetry U4^r, a y-rotation of the whole cube (see symmetry.hpp). */
+    constexpr int y_rotation(int r)
+    { return 2 * r; }
+
+    std::string_view trim(std::string_view s) {
+        const std::size_t begin = s.find_first_not_of(" \t\r");
+        if (begin == std::string_view::npos)
+        { return {}; }
+        return s.substr(begin, s.find_last_not_of(" \t\r") - begin + 1);
+    }
+
+}
+
+groubiks::solver::last_layer_db::last_layer_db()
+    : m_states(num_states), m_orientations(num_orientations)
+{ add("skip", {}); }
+
+bool groubiks::solver::last_layer_db::f2l_solved(const cube& c) {
+    for (int i = 4; i < cube::num_vertices; ++i) {
+        if (c.vertex(i) != i || c.vertex_twist(i) != 0)
+        { return false; }
+    }
+    for (int i = 4; i < cube::num_edges; ++i) {
+        if (c.edge(i) != i || c.edge_flip(i) != 0)
+        { return false; }
+    }
+    return true;
+}
+
+std::size_t groubiks::solver::last_layer_db::orientation_index(const cube& c) {
+    std::size_t twist = 0, flip = 0;
+    for (int i = 0; i < 3; ++i) {
+        twist = twist * 3 + c.vertex_twist(i);
+        flip = flip << 1 | c.edge_flip(i);
+    }
+    return twist * 8 + flip;
+}
+
+std::size_t groubiks::solver::last_layer_db::ll_index(const cube& c) {
+    const std::size_t vertices = coord::detail::rank_perm<4>([&c](int i) { return c.vertex(i); });
+    /* the edges have the parity of the vertices, ranks 2k and 2k + 1 differ in parity. */
+    const std::size_t edges = coord::detail::rank_perm<4>([&c](int i) { return c.edge(i); }) / 2;
+    const std::size_t orientation = orientation_index(c);
+    return (vertices * 12 + edges) * num_orientations + orientation;
+}
+
+void groubiks::solver::last_layer_db::store(entry& e, std::uint16_t algorithm, int pre_auf, int rotation, int post_auf,
+    std::size_t length)
+{
+    const std::size_t cost = std::min<std::size_t>(0xfe, 2 * length + (rotation != 0));
+    if (cost >= e.cost)
+    { return; }
+    e.algorithm = algorithm;
+    e.variant = std::uint8_t(pre_auf | rotation << 2 | post_auf << 4);
+    e.cost = std::uint8_t(cost);
+}
+
+bool groubiks::solver::last_layer_db::add(std::string_view name, std::span<const move_t> moves) {
+    cube alg = cube::get_solved();
+    apply_sequence(alg, moves);
+    if (!f2l_solved(alg) || m_algorithms.size() >= entry::none)
+    { return false; }
+    const auto id = std::uint16_t(m_algorithms.size());
+    m_algorithms.push_back({ std::string(name), std::vector<move_t>(moves.begin(), moves.end()) });
+
+    for (int rotation = 0; rotation < 4; ++rotation) {
+        const cube rotated = conjugate(alg, y_rotation(rotation));
+        for (int pre = 0; pre < 4; ++pre) {
+            const cube oriented = multiply(auf_cubes[pre], rotated);
+            /* the state the variant solves is its inverse. */
+            const std::size_t orientation = orientation_index(inverse(oriented));
+            if (orientation != 0)
+            { store(m_orientations[orientation], id, pre, rotation, 0, moves.size() + (pre != 0)); }
+            for (int post = 0; post < 4; ++post) {
+                entry& e = m_states[ll_index(inverse(multiply(oriented, auf_cubes[post])))];
+                m_solved_states += e.algorithm == entry::none;
+                store(e, id, pre, rotation, post, moves.size() + (pre != 0) + (post != 0));
+            }
+        }
+    }
+    return true;
+}
+
+std::vector<std::size_t> groubiks::solver::last_layer_db::read(std::istream& in) {
+    std::vector<std::size_t> rejected;
+    std::string line;
+    for (std::size_t number = 1; std::getline(in, line); ++number) {
+        std::string_view text = trim(line);
+        if (text.empty() || text.front() == '#')
+        { continue; }
+        std::string_view name = text;
+        const std::size_t colon = text.find(':');
+        if (colon != std::string_view::npos) {
+            name = trim(text.substr(0, colon));
+            text = trim(text.substr(colon + 1));
+        }
+        const std::optional<std::vector<move_t>> moves = parse_moves(text);
+        if (!moves || !add(name, *moves))
+        { rejected.push_back(number); }
+    }
+    return rejected;
+}
+
+groubiks::solver::ll_match groubiks::solver::last_layer_db::match(const entry& e, bool solves) const
+{ return { &m_algorithms[e.algorithm], e.variant & 3, e.variant >> 2 & 3, e.variant >> 4 & 3, solves }; }
+
+std::optional<groubiks::solver::ll_match> groubiks::solver::last_layer_db::find(const cube& c) const {
+    if (!f2l_solved(c))
+    { return std::nullopt; }
+    if (const entry& e = m_states[ll_index(c)]; e.algorithm != entry::none)
+    { return match(e, true); }
+    if (const entry& e = m_orientations[orientation_index(c)]; e.algorithm != entry::none)
+    { return match(e, false); }
+    return std::nullopt;
+}
+
+std::vector<groubiks::move_t> groubiks::solver::last_layer_db::moves(const ll_match& match) const {
+    std::vector<move_t> res;
+    if (match.pre_auf != 0)
+    { res.push_back(make_move(face_t::U, match.pre_auf)); }
+    for (move_t m : match.algorithm->moves)
+    { res.push_back(conjugate_move(m, y_rotation(match.rotation))); }
+    if (match.post_auf != 0)
+    { res.push_back(make_move(face_t::U, match.post_auf)); }
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file last_layer.cpp
+ * @brief last_layer.hpp unit-test.
+ */
+
+#include <set>
+#include <sstream>
+
+int groubiks::solver::last_layer_test(std::ostream& os) {
+    std::istringstream file(
+        "# two-look last layer, a few cases\n"
+        "Sune: R U R' U R U2 R'\n"
+        "Anti-Sune: R U2 R' U' R U' R'\n"
+        "\n"
+        "T-perm: R U R' U' R' F R2 U' R' U' R U R' F'\n"
+        "Ua-perm: R U' R U R U R U' R' U' R2\n"
+        "H-perm: M2 U M2 U2 M2 U M2\n"
+        "not an algorithm: R U R' U'\n"
+        "Jb-perm: R U R' F' R U R' U' R' F R2 U' R'\n"
+        "bad: R U Q\n"
+        "Y-perm with rotation: y F R U' R' U' R U R' F' R U R' U' R' F R F'\n");
+    last_layer_db db;
+    const std::vector<std::size_t> rejected = db.read(file);
+    if (rejected != std::vector<std::size_t>{ 8, 10 } || db.algorithms().size() != 8)
+    { os << "read() did not reject exactly the lines 8 and 10\n"; return 1; }
+
+    /* ll_index() numbers the reachable last-layer-states densely: a minimal perfect hash. */
+    {
+        std::vector<bool> seen(last_layer_db::num_states);
+        std::size_t count = 0;
+        for (coord::coord_t vp = 0; vp < 24; ++vp) {
+            for (coord::coord_t ep = 0; ep < 24; ++ep) {
+                for (std::size_t orientation = 0; orientation < last_layer_db::num_orientations; ++orientation) {
+                    cube c = cube::get_solved();
+                    int twists[4] = {}, flips[4] = {};
+                    for (int i = 2, t = int(orientation / 8), f = int(orientation % 8); i >= 0; --i, t /= 3, f >>= 1) {
+                        twists[i] = t % 3;
+                        flips[i] = f & 1;
+                    }
+                    twists[3] = (6 - twists[0] - twists[1] - twists[2]) % 3;
+                    flips[3] = (flips[0] + flips[1] + flips[2]) & 1;
+                    coord::detail::unrank_perm<4>(vp, [&](int i, int p) { c.set_vertex(i, p, twists[i]); });
+                    coord::detail::unrank_perm<4>(ep, [&](int i, int p) { c.set_edge(i, p, flips[i]); });
+                    if (coord::vertex_parity(c) != coord::edge_parity(c))
+                    { continue; }
+                    const std::size_t idx = last_layer_db::ll_index(c);
+                    if (idx >= last_layer_db::num_states || seen[idx])
+                    { os << "ll_index() is no perfect hash of the last-layer-states\n"; return 1; }
+                    seen[idx] = true;
+                    ++count;
+                }
+            }
+        }
+        if (count != last_layer_db::num_states || last_layer_db::ll_index(cube::get_solved()) != 0)
+        { os << count << " last-layer-states instead of " << last_layer_db::num_states << '\n'; return 1; }
+    }
+
+    /* every variant of every algorithm is found, and its moves solve the state. */
+    for (const ll_algorithm& alg : db.algorithms()) {
+        cube a = cube::get_solved();
+        apply_sequence(a, alg.moves);
+        for (int rotation = 0; rotation < 4; ++rotation) {
+            for (int pre = 0; pre < 4; ++pre) {
+                for (int post = 0; post < 4; ++post) {
+                    const cube variant = multiply(multiply(auf_cubes[pre], conjugate(a, y_rotation(rotation))), auf_cubes[post]);
+                    cube c = inverse(variant);
+                    const std::optional<ll_match> match = db.find(c);
+                    if (!match || !match->solves)
+                    { os << "no algorithm for a variant of " << alg.name << '\n'; return 1; }
+                    const std::vector<move_t> moves = db.moves(*match);
+                    apply_sequence(c, moves);
+                    if (!c.is_solved() || moves.size() > alg.moves.size() + 2)
+                    { os << match->algorithm->name << " does not solve a variant of " << alg.name << '\n'; return 1; }
+                }
+            }
+        }
+    }
+
+    /* an auf only, and the solved cube. */
+    cube auf = cube::get_solved();
+    apply_move(auf, move_t::U2);
+    const std::optional<ll_match> skip = db.find(auf);
+    if (!skip || skip->algorithm->name != "skip" || db.moves(*skip) != std::vector<move_t>{ move_t::U2 } ||
+        db.find(cube::get_solved())->algorithm->moves.size() != 0)
+    { os << "the auf-only states are not solved by the empty algorithm\n"; return 1; }
+
+    /* two looks: Sune orients the state, the T-perm then solves it. */
+    cube two_look = cube::get_solved();
+    apply_sequence(two_look, db.algorithms()[1].moves);
+    apply_sequence(two_look, db.algorithms()[3].moves);
+    two_look = inverse(two_look);
+    for (const char* expected : { "Sune", "T-perm" }) {
+        const std::optional<ll_match> step = db.find(two_look);
+        if (!step || step->algorithm->name != expected || step->solves != (expected[0] == 'T'))
+        { os << "the two-look lookup did not find " << expected << '\n'; return 1; }
+        apply_sequence(two_look, db.moves(*step));
+    }
+    if (!two_look.is_solved())
+    { os << "the two-look lookup does not solve its state\n"; return 1; }
+
+    /* nothing for a cube with unsolved first two layers. */
+    cube f2l = cube::get_solved();
+    apply_move(f2l, move_t::R);
+    if (db.find(f2l))
+    { os << "find() answered a cube with an unsolved F2L\n"; return 1; }
+
+    os << db.solved_states() << " of " << last_layer_db::num_states << " last-layer-states solved by "
+       << db.algorithms().size() << " algorithms\n";
+    os << "last_layer_test passed\n";
+    return 0;
+}
+
+#endif
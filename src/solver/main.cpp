@@ -0,0 +1,24 @@
+#include <iostream>
+#include <groubiks/solver/batch.hpp>
+#include <groubiks/solver/bidirectional.hpp>
+#include <groubiks/solver/external_bfs.hpp>
+#include <groubiks/solver/kociemba.hpp>
+#include <groubiks/solver/last_layer.hpp>
+#include <groubiks/solver/optimal.hpp>
+#include <groubiks/solver/table_file.hpp>
+#include <groubiks/solver/tables.hpp>
+#include <groubiks/solver/transposition.hpp>
+
+#ifdef BUILD_TESTS
+int main(int argc, char** argv) {
+    return groubiks::solver::table_file_test(std::cout) ||
+           groubiks::solver::tables_test(std::cout) ||
+           groubiks::solver::kociemba_test(std::cout) ||
+           groubiks::solver::optimal_test(std::cout) ||
+           groubiks::solver::transposition_test(std::cout) ||
+           groubiks::solver::batch_test(std::cout) ||
+           groubiks::solver::external_bfs_test(std::cout) ||
+           groubiks::solver::bidirectional_test(std::cout) ||
+           groubiks::solver::last_layer_test(std::cout);
+}
+#endif
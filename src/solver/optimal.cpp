@@ -0,0 +1,647 @@
+#include <groubiks/solver/optimal.hpp>
+#include <groubiks/solver/tables.hpp>
+#include <groubiks/solver/work_stealing.hpp>
+#include <groubiks/cube/coord.hpp>
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/cube/symmetry.hpp>
+
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace {
+
+    using namespace groubiks;
+    using coord::coord_t;
+    using clock_type = std::chrono::steady_clock;
+
+    constexpr int max_edge_group_size = 7;
+    constexpr int max_solution_length = 26;
+    constexpr int max_split_depth = 6;
+
+    constexpr std::size_t num_corner_entries = std::size_t(coord::num_vertex_perms) * coord::num_vertex_twists;
+    /* classes of vertex-permutations under the 16 symmetries that keep the U-D-axis. */
+    constexpr std::size_t num_corner_classes = 2768;
+    constexpr std::size_t num_reduced_corner_entries = num_corner_classes * coord::num_vertex_twists;
+
+    /* 12! / (12 - k)! placements of k distinct edges, times 2^k flips. */
+    constexpr std::size_t num_edge_group_entries(int k) {
+        std::size_t res = std::size_t(1) << k;
+        for (int i = 0; i < k; ++i)
+        { res *= cube::num_edges - i; }
+        return res;
+    }
+
+    /**
+     * @brief index of the slots and flips of k edges. the slots are counted from the
+     *        first edge of the group, so the solved group is 0, and ranked as a partial
+     *        permutation (lehmer-code over 12 - i slots for edge i).
+     *        the flips of the k edges are the lowest k bits.
+     */
+    constexpr std::size_t edge_group_rank(const int* slots, std::size_t flips, int k) {
+        std::size_t res = 0;
+        std::uint32_t used = 0;
+        for (int i = 0; i < k; ++i) {
+            res = res * (cube::num_edges - i) + (slots[i] - std::popcount(used & ((1u << slots[i]) - 1)));
+            used |= 1u << slots[i];
+        }
+        return res << k | flips;
+    }
+
+    constexpr void edge_group_unrank(std::size_t idx, int k, int* slots, std::size_t& flips) {
+        flips = idx & ((std::size_t(1) << k) - 1);
+        idx >>= k;
+        int digits[max_edge_group_size] = {};
+        for (int i = k - 1; i >= 0; --i) {
+            digits[i] = int(idx % (cube::num_edges - i));
+            idx /= cube::num_edges - i;
+        }
+        std::uint32_t unused = (1u << cube::num_edges) - 1;
+        for (int i = 0; i < k; ++i) {
+            std::uint32_t bits = unused;
+            for (int d = digits[i]; d > 0; --d)
+            { bits &= bits - 1; }
+            slots[i] = std::countr_zero(bits);
+            unused &= ~(1u << slots[i]);
+        }
+    }
+
+    /**
+     * @brief a node of the search: the cube as coordinates, moved through move-tables
+     *        instead of permuting a whole cube. edges[e] is the edge_position of edge e.
+     */
+    struct coord_state {
+        coord_t perm;
+        coord_t twist;
+        std::array<std::uint8_t, cube::num_edges> edges;
+    };
+
+    constexpr std::array<std::uint8_t, cube::num_edges> solved_edges = [] {
+        std::array<std::uint8_t, cube::num_edges> res{};
+        for (int e = 0; e < cube::num_edges; ++e)
+        { res[e] = std::uint8_t(2 * e); }
+        return res;
+    }();
+
+    /* edge_group_rank() of the edges first..first+k-1 of a state. */
+    constexpr std::size_t edge_group_index(const coord_state& state, int first, int k) {
+        int slots[max_edge_group_size] = {};
+        std::size_t flips = 0;
+        for (int e = 0; e < k; ++e) {
+            const int pos = state.edges[first + e];
+            slots[e] = (pos / 2 - first + cube::num_edges) % cube::num_edges;
+            flips |= std::size_t(pos & 1) << e;
+        }
+        return edge_group_rank(slots, flips, k);
+    }
+
+}
+
+namespace groubiks::solver {
+
+    struct optimal_tables {
+        pattern_config config;
+        /* the coordinates of a search-node, [coord * num_moves + move]. */
+        coord_move_table<std::uint16_t> perm_move;
+        coord_move_table<std::uint16_t> twist_move;
+        coord_move_table<std::uint8_t> edge_move;
+        nibble_table corners;
+        /*
+         * with config.corner_symmetry: corners is indexed by (class of the vertex-permutation, twist),
+         * the twist conjugated by the symmetry that turns the permutation into its representative.
+         */
+        flat_table<std::uint16_t> corner_class;
+        flat_table<std::uint8_t> corner_symmetry;
+        /* [twist * num_ud_symmetries + s] */
+        flat_table<std::uint16_t> twist_conjugation;
+        /* edges 0..k-1 and 12-k..11 */
+        nibble_table edges[2];
+        int edge_first[2] = {};
+        /* set if the tables above point into a mapped table-file. */
+        std::optional<table_file> file;
+
+        explicit optimal_tables(const pattern_config& cfg);
+        void generate();
+
+        std::size_t corner_index(coord_t perm, coord_t twist) const {
+            if (!config.corner_symmetry)
+            { return std::size_t(perm) * coord::num_vertex_twists + twist; }
+            return std::size_t(corner_class[perm]) * coord::num_vertex_twists
+                + twist_conjugation[std::size_t(twist) * num_ud_symmetries + corner_symmetry[perm]];
+        }
+        std::size_t corner_index(const cube& c) const
+        { return corner_index(coord::vertex_perm(c), coord::vertex_twist(c)); }
+
+        coord_state coords(const cube& c) const {
+            coord_state res{ coord::vertex_perm(c), coord::vertex_twist(c), {} };
+            for (int e = 0; e < cube::num_edges; ++e)
+            { res.edges[e] = std::uint8_t(coord::edge_position(c, e)); }
+            return res;
+        }
+
+        /* `res` is `state` after move m, in two steps, so a search can prune on the corners first. */
+        void move_corners(const coord_state& state, int m, coord_state& res) const {
+            res.perm = perm_move.next(state.perm, m);
+            res.twist = twist_move.next(state.twist, m);
+        }
+        void move_edges(const coord_state& state, int m, coord_state& res) const {
+            for (int e = 0; e < cube::num_edges; ++e)
+            { res.edges[e] = std::uint8_t(edge_move.next(state.edges[e], m)); }
+        }
+
+        template<class Fn>
+        void for_each_table(Fn&& fn) {
+            const int k = config.edge_group_size;
+            fn("perm_move", perm_move, std::size_t(coord::num_vertex_perms) * num_moves);
+            fn("twist_move", twist_move, std::size_t(coord::num_vertex_twists) * num_moves);
+            fn("edge_position_move", edge_move, std::size_t(coord::num_edge_positions) * num_moves);
+            if (config.corners && config.corner_symmetry) {
+                fn("corner_class", corner_class, coord::num_vertex_perms);
+                fn("corner_symmetry", corner_symmetry, coord::num_vertex_perms);
+                fn("twist_conjugation", twist_conjugation, std::size_t(coord::num_vertex_twists) * num_ud_symmetries);
+                fn("corners_sym16", corners, num_reduced_corner_entries);
+            }
+            else if (config.corners)
+            { fn("corners", corners, num_corner_entries); }
+            if (k > 0) {
+                const std::string suffix = std::to_string(k);
+                fn("edges" + suffix + "_first", edges[0], num_edge_group_entries(k));
+                fn("edges" + suffix + "_last", edges[1], num_edge_group_entries(k));
+            }
+        }
+    };
+
+    optimal_tables::optimal_tables(const pattern_config& cfg)
+        : config{ cfg.corners, std::max(0, std::min(cfg.edge_group_size, max_edge_group_size)), cfg.generator_threads,
+                  cfg.corner_symmetry }
+    {
+        edge_first[0] = 0;
+        edge_first[1] = cube::num_edges - config.edge_group_size;
+    }
+
+    void optimal_tables::generate() {
+        std::array<move_t, num_moves> all_moves{};
+        for (int m = 0; m < num_moves; ++m)
+        { all_moves[m] = move_t(m); }
+        perm_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_perm_coord, all_moves);
+        twist_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves);
+        edge_move = generate_move_table<std::uint8_t, num_moves>(coord::edge_position_coord, all_moves);
+
+        if (config.corners) {
+            std::vector<coord_t> representatives;
+            std::vector<std::uint64_t> stabilizers;
+            if (config.corner_symmetry) {
+                const auto perm_conjugation = build_conjugation_table<std::uint16_t>(coord::num_vertex_perms,
+                    num_ud_symmetries, coord::set_vertex_perm, coord::vertex_perm);
+                symmetry_classes classes = build_symmetry_classes(coord::num_vertex_perms, num_ud_symmetries, perm_conjugation);
+                corner_class = flat_table(std::move(classes.class_of));
+                corner_symmetry = flat_table(std::move(classes.symmetry_of));
+                twist_conjugation = flat_table(build_conjugation_table<std::uint16_t>(coord::num_vertex_twists,
+                    num_ud_symmetries, coord::set_vertex_twist, coord::vertex_twist));
+                representatives = std::move(classes.representatives);
+                stabilizers = std::move(classes.stabilizers);
+            }
+            /*
+             * an entry stands for its permutation (the representative of a class) and twist.
+             * a neighbour with a symmetric representative is visited with all twists it can be
+             * conjugated to, otherwise only one of its entries would be reached from this side.
+             */
+            corners = build_nibble_table(config.corner_symmetry ? num_reduced_corner_entries : num_corner_entries,
+                [&](std::size_t i, auto&& visit) {
+                    const std::size_t row = i / coord::num_vertex_twists, twist = i % coord::num_vertex_twists;
+                    const std::size_t perm = config.corner_symmetry ? representatives[row] : row;
+                    for (int m = 0; m < num_moves; ++m) {
+                        const std::size_t next = corner_index(perm_move.next(coord_t(perm), m), twist_move.next(coord_t(twist), m));
+                        if (visit(next))
+                        { return; }
+                        if (!config.corner_symmetry)
+                        { continue; }
+                        const std::size_t next_row = next / coord::num_vertex_twists, next_twist = next % coord::num_vertex_twists;
+                        for (std::uint64_t syms = stabilizers[next_row] & ~std::uint64_t(1); syms != 0; syms &= syms - 1) {
+                            const int s = std::countr_zero(syms);
+                            if (visit(next_row * coord::num_vertex_twists + twist_conjugation[next_twist * num_ud_symmetries + s]))
+                            { return; }
+                        }
+                    }
+                }, generator_config{ config.generator_threads, "optimal corners" });
+        }
+
+        const int k = config.edge_group_size;
+        if (k > 0) {
+            for (int g = 0; g < 2; ++g) {
+                const int first = edge_first[g];
+                edges[g] = build_nibble_table(num_edge_group_entries(k), [&](std::size_t i, auto&& visit) {
+                    int slots[max_edge_group_size];
+                    std::size_t flips;
+                    edge_group_unrank(i, k, slots, flips);
+                    for (int m = 0; m < num_moves; ++m) {
+                        int moved[max_edge_group_size];
+                        std::size_t moved_flips = 0;
+                        for (int e = 0; e < k; ++e) {
+                            const coord_t pos = edge_move.next(coord_t((slots[e] + first) % cube::num_edges * 2 + (flips >> e & 1)), m);
+                            moved[e] = (int(pos / 2) - first + cube::num_edges) % cube::num_edges;
+                            moved_flips |= std::size_t(pos & 1) << e;
+                        }
+                        if (visit(edge_group_rank(moved, moved_flips, k)))
+                        { return; }
+                    }
+                }, generator_config{ config.generator_threads, g == 0 ? "optimal first edges" : "optimal last edges" });
+            }
+        }
+    }
+
+}
+
+namespace {
+
+    using groubiks::solver::optimal_tables;
+
+    /* the root of a subtree of the search, handed to the workers of a parallel search. */
+    struct subtree {
+        coord_state c;
+        std::array<move_t, max_split_depth> prefix;
+        int depth;
+        /* state of the move-automaton after the prefix. */
+        int state;
+    };
+
+    /**
+     * @brief state of a single search-thread: iterative deepening over the total length,
+     *        a branch is cut as soon as one table proves that it cannot finish in time.
+     *        the search stops at the deadline or as soon as `cancel` is set.
+     */
+    class ida_search {
+    public:
+        ida_search(const optimal_tables& tables, clock_type::time_point deadline, const std::atomic<bool>* cancel = nullptr)
+            : m_tables(tables), m_deadline(deadline), m_cancel(cancel) {}
+
+        int bound(const coord_state& c) {
+            int res = 0;
+            if (m_tables.config.corners)
+            { res = std::max<int>(res, corner_distance(c)); }
+            for (int g = 0; g < 2 && m_tables.config.edge_group_size > 0; ++g)
+            { res = std::max<int>(res, edge_distance(c, g)); }
+            return res;
+        }
+
+        bool run(const coord_state& c, int max_length) {
+            for (int depth = bound(c); depth <= max_length && !m_stopped; ++depth) {
+                if (search_root(c, depth))
+                { return true; }
+            }
+            return false;
+        }
+
+        /* a single iteration: searches for a solution of exactly `length` moves. */
+        bool search_root(const coord_state& c, int length) {
+            m_length = length;
+            return search(c, 0, length, sequence_start);
+        }
+
+        /**
+         * @brief calls emit(subtree) for every node `split_depth` moves below c
+         *        that may still lead to a solution of exactly `length` moves.
+         */
+        template<class Emit>
+        void split(const coord_state& c, int split_depth, int length, Emit&& emit)
+        { split(c, 0, split_depth, length, sequence_start, emit); }
+
+        bool search_subtree(const subtree& t, int length) {
+            std::copy(t.prefix.begin(), t.prefix.begin() + t.depth, m_path.begin());
+            m_length = length;
+            return search(t.c, t.depth, length - t.depth, t.state);
+        }
+
+        bool stopped() const { return m_stopped; }
+        bool timed_out() const { return m_timed_out; }
+
+        std::vector<move_t> path() const
+        { return std::vector<move_t>(m_path.begin(), m_path.begin() + m_length); }
+        std::uint64_t nodes() const { return m_nodes; }
+        std::uint64_t lookups() const { return m_lookups; }
+
+    private:
+        std::uint8_t corner_distance(const coord_state& c) {
+            ++m_lookups;
+            return m_tables.corners.get(m_tables.corner_index(c.perm, c.twist));
+        }
+
+        std::uint8_t edge_distance(const coord_state& c, int g) {
+            ++m_lookups;
+            return m_tables.edges[g].get(edge_group_index(c, m_tables.edge_first[g], m_tables.config.edge_group_size));
+        }
+
+        /**
+         * @brief moves c by m into next, unless a table proves bound(next) >= togo.
+         *        stops at the first table that prunes, the edges are not even moved
+         *        if the corners prune.
+         * @returns false if next was pruned.
+         */
+        bool advance(const coord_state& c, int m, int togo, coord_state& next) {
+            m_tables.move_corners(c, m, next);
+            if (m_tables.config.corners && corner_distance(next) >= togo)
+            { return false; }
+            m_tables.move_edges(c, m, next);
+            for (int g = 0; g < 2 && m_tables.config.edge_group_size > 0; ++g) {
+                if (edge_distance(next, g) >= togo)
+                { return false; }
+            }
+            return true;
+        }
+
+        template<class Emit>
+        void split(const coord_state& c, int depth, int split_depth, int length, int state, Emit& emit) {
+            if (depth == split_depth) {
+                subtree t{ c, {}, depth, state };
+                std::copy(m_path.begin(), m_path.begin() + depth, t.prefix.begin());
+                emit(t);
+                return;
+            }
+            ++m_nodes;
+            for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+                const move_t m = move_t(std::countr_zero(moves));
+                coord_state next;
+                if (!advance(c, int(m), length - depth, next))
+                { continue; }
+                m_path[depth] = m;
+                split(next, depth + 1, split_depth, length, next_sequence_state(m), emit);
+            }
+        }
+
+        void check_stop() {
+            if (clock_type::now() > m_deadline)
+            { m_stopped = m_timed_out = true; }
+            if (m_cancel != nullptr && m_cancel->load(std::memory_order_relaxed))
+            { m_stopped = true; }
+        }
+
+        bool search(const coord_state& c, int depth, int togo, int state) {
+            if (togo == 0)
+            { return c.perm == 0 && c.twist == 0 && c.edges == solved_edges; }
+            if ((++m_nodes & 0x3ff) == 0)
+            { check_stop(); }
+            if (m_stopped)
+            { return false; }
+            for (std::uint32_t moves = successor_moves[state]; moves != 0; moves &= moves - 1) {
+                const move_t m = move_t(std::countr_zero(moves));
+                coord_state next;
+                if (!advance(c, int(m), togo, next))
+                { continue; }
+                m_path[depth] = m;
+                if (search(next, depth + 1, togo - 1, next_sequence_state(m)))
+                { return true; }
+            }
+            return false;
+        }
+
+        const optimal_tables& m_tables;
+        const clock_type::time_point m_deadline;
+        const std::atomic<bool>* m_cancel;
+
+        std::array<move_t, max_solution_length + 1> m_path{};
+        int m_length = 0;
+        std::uint64_t m_nodes = 0;
+        std::uint64_t m_lookups = 0;
+        bool m_stopped = false;
+        bool m_timed_out = false;
+    };
+
+}
+
+groubiks::solver::optimal::optimal(const pattern_config& config) {
+    auto tables = std::make_unique<optimal_tables>(config);
+    tables->generate();
+    m_tables = std::move(tables);
+}
+
+groubiks::solver::optimal::optimal(const pattern_config& config, const std::filesystem::path& table_path, bool verify) {
+    auto tables = std::make_unique<optimal_tables>(config);
+    load_or_generate(*tables, table_path, verify);
+    m_tables = std::move(tables);
+}
+
+groubiks::solver::optimal::~optimal() = default;
+
+const groubiks::solver::pattern_config& groubiks::solver::optimal::config() const
+{ return m_tables->config; }
+
+std::size_t groubiks::solver::optimal::table_bytes() const
+{
+    return m_tables->corners.bytes() + m_tables->edges[0].bytes() + m_tables->edges[1].bytes()
+        + m_tables->corner_class.elements().size_bytes() + m_tables->corner_symmetry.elements().size_bytes()
+        + m_tables->twist_conjugation.elements().size_bytes();
+}
+
+groubiks::solver::solution groubiks::solver::optimal::solve(const cube& c, int max_length, std::chrono::milliseconds timeout) const {
+    const auto start = clock_type::now();
+    ida_search search(*m_tables, start + timeout);
+
+    solution res;
+    res.found = search.run(m_tables->coords(c), std::min(max_length, max_solution_length));
+    res.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    res.nodes = search.nodes();
+    res.lookups = search.lookups();
+    if (res.found)
+    { res.moves = search.path(); }
+    return res;
+}
+
+groubiks::solver::solution groubiks::solver::optimal::solve(const cube& c, int max_length, std::chrono::milliseconds timeout,
+    const parallel_config& parallel) const
+{
+    const auto start = clock_type::now();
+    const auto deadline = start + timeout;
+    const int num_workers = parallel.threads > 0 ? parallel.threads : int(std::max(1u, std::thread::hardware_concurrency()));
+    const int split_depth = std::max(1, std::min(parallel.split_depth, max_split_depth));
+    max_length = std::min(max_length, max_solution_length);
+    const coord_state coords = m_tables->coords(c);
+
+    /* the shallow iterations and the splitting run on the calling thread. */
+    ida_search root(*m_tables, deadline);
+    solution res;
+    std::mutex result_lock;
+    std::atomic<bool> cancel = false;
+    bool timed_out = false;
+
+    for (int length = root.bound(coords); length <= max_length && !res.found && !timed_out; ++length) {
+        if (length <= split_depth || num_workers == 1) {
+            if (root.search_root(coords, length)) {
+                res.found = true;
+                res.moves = root.path();
+            }
+            timed_out = root.timed_out();
+            continue;
+        }
+
+        work_stealing_queues<subtree> queues(num_workers);
+        int next_worker = 0;
+        root.split(coords, split_depth, length, [&](const subtree& t) {
+            queues.push(next_worker, t);
+            next_worker = (next_worker + 1) % num_workers;
+        });
+
+        run_workers(num_workers, [&](int worker) {
+            ida_search search(*m_tables, deadline, &cancel);
+            while (!search.stopped()) {
+                const std::optional<subtree> t = queues.pop(worker);
+                if (!t)
+                { break; }
+                if (search.search_subtree(*t, length)) {
+                    /* every solution of this iteration is optimal, the first one wins. */
+                    std::lock_guard lock(result_lock);
+                    if (!res.found) {
+                        res.found = true;
+                        res.moves = search.path();
+                    }
+                    cancel.store(true, std::memory_order_relaxed);
+                }
+            }
+            std::lock_guard lock(result_lock);
+            res.nodes += search.nodes();
+            res.lookups += search.lookups();
+            timed_out |= search.timed_out();
+        });
+    }
+
+    res.seconds = std::chrono::duration<double>(clock_type::now() - start).count();
+    res.nodes += root.nodes();
+    res.lookups += root.lookups();
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file optimal.cpp
+ * @brief optimal.hpp unit-test.
+ */
+
+namespace {
+
+    /* plain depth-first search without any pruning, as reference for short scrambles. */
+    template<class Goal>
+    bool brute_force(const groubiks::cube& c, int togo, int last_face, Goal&& goal) {
+        if (togo == 0)
+        { return goal(c); }
+        for (int m = 0; m < groubiks::num_moves; ++m) {
+            if (m / 3 == last_face)
+            { continue; }
+            groubiks::cube next = c;
+            groubiks::apply_move(next, groubiks::move_t(m));
+            if (brute_force(next, togo - 1, m / 3, goal))
+            { return true; }
+        }
+        return false;
+    }
+
+    bool brute_force(const groubiks::cube& c, int togo, int last_face)
+    { return brute_force(c, togo, last_face, [](const groubiks::cube& x) { return x.is_solved(); }); }
+
+}
+
+int groubiks::solver::optimal_test(std::ostream& os) {
+    for (std::size_t idx : { std::size_t(0), std::size_t(12345), num_edge_group_entries(4) - 1 }) {
+        int slots[max_edge_group_size];
+        std::size_t flips;
+        edge_group_unrank(idx, 4, slots, flips);
+        if (edge_group_rank(slots, flips, 4) != idx)
+        { os << "edge-group-index " << idx << " does not survive unranking\n"; return 1; }
+    }
+
+    const optimal solver(pattern_config{ false, 4 });
+
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+    auto next_move = [&state]() {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        return move_t(state % num_moves);
+    };
+
+    for (int k = 0; k < 30; ++k) {
+        cube c = cube::get_solved();
+        const int scramble = k % 7;
+        for (int i = 0; i < scramble; ++i)
+        { apply_move(c, next_move()); }
+
+        const solution s = solver.solve(c, scramble, std::chrono::milliseconds(10000));
+        cube solved = c;
+        apply_sequence(solved, s.moves);
+        if (!s.found || !solved.is_solved())
+        { os << "no valid solution within " << scramble << " moves for cube " << k << '\n'; return 1; }
+        if (s.length() > 0 && brute_force(c, s.length() - 1, -1))
+        { os << "solution " << s << " of cube " << k << " is not optimal\n"; return 1; }
+
+        const solution p = solver.solve(c, scramble, std::chrono::milliseconds(10000), parallel_config{ 4, 2 });
+        solved = c;
+        apply_sequence(solved, p.moves);
+        if (!p.found || !solved.is_solved() || p.length() != s.length())
+        { os << "the parallel search found no optimal solution for cube " << k << '\n'; return 1; }
+        if (k % 7 == 6) {
+            os << "length " << s.length() << ": " << s.nodes << " nodes, " << s.lookups << " lookups, "
+               << s.seconds * 1e3 << " ms\n";
+        }
+    }
+
+    /* far too deep for the small tables. */
+    constexpr move_t deep[] = { move_t::R, move_t::U, move_t::F, move_t::Dp, move_t::L2, move_t::B,
+        move_t::R2, move_t::Up, move_t::F2, move_t::D, move_t::Lp, move_t::B2 };
+    cube c = cube::get_solved();
+    apply_sequence(c, deep);
+    if (solver.solve(c, 12, std::chrono::milliseconds(1)).found)
+    { os << "the search ignores its timeout\n"; return 1; }
+
+    /* the symmetry-reduced corner-table holds the exact corner-distance, the same for all 48 conjugates. */
+    {
+        optimal_tables tables(pattern_config{ true, 0 });
+        tables.generate();
+        auto corners_solved = [](const cube& x) { return x.vertex_bits == cube::solved_vertex_bits(); };
+        for (int k = 0; k < 40; ++k) {
+            cube x = cube::get_solved();
+            const int scramble = k < 20 ? k % 6 : 30;
+            for (int i = 0; i < scramble; ++i)
+            { apply_move(x, next_move()); }
+            /* pure twists: the solved permutation is fixed by every symmetry. */
+            if (k >= 30)
+            { x = cube::get_solved(); coord::set_vertex_twist(x, coord_t(state % coord::num_vertex_twists)); }
+            const int d = tables.corners.get(tables.corner_index(x));
+            for (int s = 0; s < num_symmetries; ++s) {
+                if (tables.corners.get(tables.corner_index(conjugate(x, s))) != d)
+                { os << "corner-distance of cube " << k << " changes under symmetry " << s << '\n'; return 1; }
+            }
+            if (scramble > 5)
+            { continue; }
+            bool shorter = false;
+            for (int len = 0; len < d && !shorter; ++len)
+            { shorter = brute_force(x, len, -1, corners_solved); }
+            if (shorter || !brute_force(x, d, -1, corners_solved))
+            { os << "corner-distance " << d << " of cube " << k << " is wrong\n"; return 1; }
+        }
+    }
+
+    /* the first solver generates and writes the table-file, the second maps it. */
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "groubiks_optimal_test.tables";
+    std::filesystem::remove(path);
+    {
+        const optimal written(pattern_config{ false, 4 }, path);
+        const optimal mapped(pattern_config{ false, 4 }, path);
+        if (!std::filesystem::exists(path) || mapped.table_bytes() != solver.table_bytes())
+        { os << "the table-file was not written\n"; return 1; }
+        cube m = cube::get_solved();
+        apply_sequence(m, std::span(deep).first(5));
+        const solution s = mapped.solve(m, 5, std::chrono::milliseconds(10000));
+        if (!s.found || s.length() != solver.solve(m, 5, std::chrono::milliseconds(10000)).length())
+        { os << "the mapped tables disagree with the generated ones\n"; return 1; }
+    }
+    std::filesystem::remove(path);
+
+    os << "optimal_test passed\n";
+    return 0;
+}
+
+#endif
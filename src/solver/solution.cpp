@@ -0,0 +1,10 @@
+#include <groubiks/solver/solution.hpp>
+
+std::ostream& groubiks::solver::operator<<(std::ostream& os, const solution& s) {
+    for (std::size_t i = 0; i < s.moves.size(); ++i) {
+        if (i != 0)
+        { os << ' '; }
+        os << move_names[std::uint8_t(s.moves[i])];
+    }
+    return os;
+}
@@ -0,0 +1,239 @@
+#include <groubiks/solver/table_file.hpp>
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <cstring>
+#include <fstream>
+#include <functional>
+#include <system_error>
+#include <thread>
+#include <utility>
+
+/* after all other headers, common.h defines macros like check() and clamp(). */
+extern "C" {
+    #include <groubiks/utility/common.h>
+}
+
+namespace {
+
+    using groubiks::solver::table_file;
+
+    constexpr std::array<char, 8> magic = { 'G', 'R', 'B', 'K', 'T', 'B', 'L', '\0' };
+
+    struct file_header {
+        std::array<char, 8> magic;
+        std::uint32_t version;
+        std::uint32_t num_sections;
+        std::uint64_t file_size;
+        std::uint64_t directory_checksum;
+    };
+
+    struct directory_entry {
+        char name[table_file::max_name_length + 1];
+        std::uint64_t offset;
+        std::uint64_t size;
+        std::uint64_t checksum;
+    };
+
+    static_assert(sizeof(file_header) == 32 && sizeof(directory_entry) == 64);
+    constexpr std::size_t max_sections = (table_file::page_size - sizeof(file_header)) / sizeof(directory_entry);
+
+    constexpr std::size_t page_align(std::size_t n)
+    { return (n + table_file::page_size - 1) / table_file::page_size * table_file::page_size; }
+
+}
+
+std::uint64_t groubiks::solver::table_checksum(std::span<const std::uint8_t> data) {
+    /* four independent multiply-xor lanes over 8-byte words, so the pass runs near memory-speed. */
+    constexpr std::uint64_t prime = 0x9e3779b97f4a7c15ull;
+    std::uint64_t lanes[4] = { 1, 2, 3, 4 };
+    std::size_t i = 0;
+    for (; i + 32 <= data.size(); i += 32) {
+        for (int l = 0; l < 4; ++l) {
+            std::uint64_t w;
+            std::memcpy(&w, data.data() + i + 8 * l, 8);
+            lanes[l] = (lanes[l] ^ w) * prime;
+            lanes[l] ^= lanes[l] >> 29;
+        }
+    }
+    std::uint64_t res = data.size();
+    for (std::uint64_t l : lanes)
+    { res = (res ^ l) * prime; }
+    for (; i < data.size(); ++i)
+    { res = (res ^ data[i]) * prime; }
+    return res ^ (res >> 32);
+}
+
+std::optional<groubiks::solver::table_file> groubiks::solver::table_file::open(const std::filesystem::path& path, bool verify) {
+    const void* data = nullptr;
+    std::size_t size = 0;
+    if (mapFile(path.string().c_str(), &data, &size) != 0)
+    { return std::nullopt; }
+    table_file res(data, size);
+
+    const auto* bytes = static_cast<const std::uint8_t*>(data);
+    file_header header;
+    if (size < page_size)
+    { return std::nullopt; }
+    std::memcpy(&header, bytes, sizeof(header));
+    if (header.magic != magic || header.version != version || header.file_size != size ||
+        header.num_sections > max_sections)
+    { return std::nullopt; }
+
+    const std::span<const std::uint8_t> directory(bytes + sizeof(header), header.num_sections * sizeof(directory_entry));
+    if (verify && table_checksum(directory) != header.directory_checksum)
+    { return std::nullopt; }
+
+    for (std::uint32_t i = 0; i < header.num_sections; ++i) {
+        directory_entry e;
+        std::memcpy(&e, directory.data() + i * sizeof(e), sizeof(e));
+        e.name[max_name_length] = '\0';
+        if (e.offset % page_size != 0 || e.offset > size || e.size > size - e.offset)
+        { return std::nullopt; }
+        const std::span<const std::uint8_t> section_data(bytes + e.offset, e.size);
+        if (verify && table_checksum(section_data) != e.checksum)
+        { return std::nullopt; }
+        res.m_sections.push_back({ e.name, section_data });
+    }
+    return res;
+}
+
+groubiks::solver::table_file::table_file(table_file&& other) noexcept
+    : m_data(std::exchange(other.m_data, nullptr)), m_size(std::exchange(other.m_size, 0)),
+      m_sections(std::move(other.m_sections)) {}
+
+groubiks::solver::table_file& groubiks::solver::table_file::operator=(table_file&& other) noexcept {
+    if (this != &other) {
+        unmapFile(m_data, m_size);
+        m_data = std::exchange(other.m_data, nullptr);
+        m_size = std::exchange(other.m_size, 0);
+        m_sections = std::move(other.m_sections);
+    }
+    return *this;
+}
+
+groubiks::solver::table_file::~table_file()
+{ unmapFile(m_data, m_size); }
+
+std::optional<std::span<const std::uint8_t>> groubiks::solver::table_file::section(std::string_view name) const {
+    for (const entry& e : m_sections) {
+        if (e.name == name)
+        { return e.data; }
+    }
+    return std::nullopt;
+}
+
+bool groubiks::solver::table_file_writer::add(std::string_view name, std::span<const std::uint8_t> data) {
+    if (name.size() > table_file::max_name_length || m_sections.size() == max_sections)
+    { return false; }
+    for (const entry& e : m_sections) {
+        if (e.name == name)
+        { return false; }
+    }
+    m_sections.push_back({ std::string(name), data });
+    return true;
+}
+
+bool groubiks::solver::table_file_writer::write(const std::filesystem::path& path) const {
+    std::vector<std::uint8_t> first_page(table_file::page_size, 0);
+    std::size_t offset = table_file::page_size;
+    for (std::size_t i = 0; i < m_sections.size(); ++i) {
+        directory_entry e{};
+        std::copy(m_sections[i].name.begin(), m_sections[i].name.end(), e.name);
+        e.offset = offset;
+        e.size = m_sections[i].data.size();
+        e.checksum = table_checksum(m_sections[i].data);
+        std::memcpy(first_page.data() + sizeof(file_header) + i * sizeof(e), &e, sizeof(e));
+        offset += page_align(e.size);
+    }
+    const file_header header{ magic, table_file::version, std::uint32_t(m_sections.size()), offset,
+        table_checksum(std::span(first_page).subspan(sizeof(file_header), m_sections.size() * sizeof(directory_entry))) };
+    std::memcpy(first_page.data(), &header, sizeof(header));
+
+    /* unique per writer, so concurrent generate-if-missing calls do not clobber each other. */
+    std::filesystem::path tmp = path;
+    tmp += ".tmp" + std::to_string(std::hash<std::thread::id>{}(std::this_thread::get_id()) ^
+        std::uint64_t(std::chrono::steady_clock::now().time_since_epoch().count()));
+    {
+        std::ofstream out(tmp, std::ios::binary | std::ios::trunc);
+        out.write(reinterpret_cast<const char*>(first_page.data()), first_page.size());
+        const std::vector<char> padding(table_file::page_size, 0);
+        for (const entry& e : m_sections) {
+            out.write(reinterpret_cast<const char*>(e.data.data()), e.data.size());
+            out.write(padding.data(), page_align(e.data.size()) - e.data.size());
+        }
+        if (!out.flush()) {
+            out.close();
+            std::error_code ec;
+            std::filesystem::remove(tmp, ec);
+            return false;
+        }
+    }
+    std::error_code ec;
+    std::filesystem::rename(tmp, path, ec);
+    if (ec) {
+        std::filesystem::remove(tmp, ec);
+        return false;
+    }
+    return true;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file table_file.cpp
+ * @brief table_file.hpp unit-test.
+ */
+
+int groubiks::solver::table_file_test(std::ostream& os) {
+    const std::filesystem::path path = std::filesystem::temp_directory_path() / "groubiks_table_file_test.bin";
+
+    std::vector<std::uint8_t> a(10000);
+    std::vector<std::uint16_t> b(777);
+    for (std::size_t i = 0; i < a.size(); ++i)
+    { a[i] = std::uint8_t(i * 7); }
+    for (std::size_t i = 0; i < b.size(); ++i)
+    { b[i] = std::uint16_t(i * 31); }
+
+    table_file_writer writer;
+    if (!writer.add("a", a) || !writer.add("b", as_table_bytes(std::span<const std::uint16_t>(b))) || writer.add("a", a))
+    { os << "table_file_writer accepted a duplicate or rejected a section\n"; return 1; }
+    if (!writer.write(path))
+    { os << "could not write " << path << '\n'; return 1; }
+
+    {
+        const std::optional<table_file> file = table_file::open(path);
+        if (!file || file->size() % table_file::page_size != 0)
+        { os << "could not open the written table-file\n"; return 1; }
+        const auto sa = file->section("a");
+        const auto sb = file->section("b");
+        if (!sa || !sb || file->section("c"))
+        { os << "table-file sections are missing\n"; return 1; }
+        if (reinterpret_cast<std::uintptr_t>(sb->data()) % table_file::page_size != 0)
+        { os << "table-file sections are not page-aligned\n"; return 1; }
+        if (!std::equal(a.begin(), a.end(), sa->begin()) ||
+            !std::equal(b.begin(), b.end(), reinterpret_cast<const std::uint16_t*>(sb->data())))
+        { os << "table-file sections differ from the written data\n"; return 1; }
+    }
+
+    /* flip one byte of section a. */
+    {
+        std::fstream f(path, std::ios::binary | std::ios::in | std::ios::out);
+        f.seekp(2 * table_file::page_size + 5);
+        f.put(char(0x5a));
+    }
+    if (table_file::open(path))
+    { os << "a corrupted table-file passed the checksum\n"; return 1; }
+    if (!table_file::open(path, false))
+    { os << "opening without verification failed\n"; return 1; }
+
+    std::filesystem::remove(path);
+    if (table_file::open(path))
+    { os << "opened a missing table-file\n"; return 1; }
+
+    os << "table_file_test passed\n";
+    return 0;
+}
+
+#endif
@@ -0,0 +1,156 @@
+#include <groubiks/solver/tables.hpp>
+
+#include <array>
+#include <deque>
+
+/* after all other headers, log.h defines macros like log() and check(). */
+extern "C" {
+    #include <groubiks/utility/log.h>
+}
+
+groubiks::solver::symmetry_classes groubiks::solver::build_symmetry_classes(coord::coord_t count, int num_syms,
+    std::span<const std::uint16_t> conjugation)
+{
+    return build_symmetry_classes_by(count, num_syms,
+        [conjugation, num_syms](coord::coord_t c, int s) { return coord::coord_t(conjugation[std::size_t(c) * num_syms + s]); });
+}
+
+void groubiks::solver::detail::log_table_level(const char* name, int depth, bool backward, std::size_t found,
+    std::size_t visited, std::size_t size, double seconds)
+{
+    if (name == nullptr || !log_initialized())
+    { return; }
+    logf_info("%s: depth %d (%s), %zu new, %zu of %zu visited, %.3f s, %.1f M indices/s",
+        name, depth, backward ? "backward" : "forward", found, visited, size,
+        seconds, seconds > 0.0 ? double(size) / seconds / 1e6 : 0.0);
+}
+
+void groubiks::solver::detail::log_table_done(const char* name, std::size_t size, std::size_t bytes, double seconds) {
+    if (name == nullptr || !log_initialized())
+    { return; }
+    logf_info("%s: %zu entries (%zu bytes) generated in %.3f s", name, size, bytes, seconds);
+}
+
+void groubiks::solver::detail::log_table_file(const std::filesystem::path& path, const char* event) {
+    if (!log_initialized())
+    { return; }
+    logf_info("table-file %s: %s", path.string().c_str(), event);
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file tables.cpp
+ * @brief tables.hpp unit-test.
+ */
+
+int groubiks::solver::tables_test(std::ostream& os) {
+    std::array<move_t, num_moves> all_moves{};
+    for (int m = 0; m < num_moves; ++m)
+    { all_moves[m] = move_t(m); }
+
+    /* both layouts of every coordinate-type follow a random walk of a whole cube. */
+    for (const coord::coordinate& type : { coord::vertex_twist_coord, coord::edge_flip_coord, coord::vertex_perm_coord,
+        coord::ud_slice_coord, coord::edge_position_coord })
+    {
+        const auto by_coord = generate_move_table<std::uint16_t, num_moves>(type, all_moves);
+        const auto by_move = generate_move_table<std::uint16_t, num_moves, table_layout::move_major>(type, all_moves);
+        cube c = cube::get_solved();
+        coord::coord_t x = 0, y = 0;
+        std::uint64_t state = 0x2545f4914f6cdd1dull;
+        for (int i = 0; i < 1000; ++i) {
+            state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+            const int m = int(state % num_moves);
+            apply_move(c, move_t(m));
+            x = by_coord.next(x, m);
+            y = by_move.next(y, m);
+            if (x != type.rank(c) || y != type.rank(c))
+            { os << "the move-tables of " << type.name << " disagree with the cube after " << i + 1 << " moves\n"; return 1; }
+        }
+    }
+
+    const auto twist_move = generate_move_table<std::uint16_t, num_moves>(coord::vertex_twist_coord, all_moves);
+    const auto slice_move = generate_move_table<std::uint16_t, num_moves>(coord::ud_slice_coord, all_moves);
+
+    /* (slice, twist), one of the phase-1 tables of the kociemba-solver. */
+    const std::size_t size = std::size_t(coord::num_ud_slices) * coord::num_vertex_twists;
+    auto next = [&](std::size_t i, int m) {
+        const coord::coord_t slice = coord::coord_t(i / coord::num_vertex_twists), twist = coord::coord_t(i % coord::num_vertex_twists);
+        return std::size_t(slice_move.next(slice, m)) * coord::num_vertex_twists + twist_move.next(twist, m);
+    };
+
+    /* reference: plain single-threaded bfs with a queue. */
+    std::vector<std::uint8_t> expected(size, byte_table::unvisited);
+    std::deque<std::size_t> queue{ 0 };
+    expected[0] = 0;
+    while (!queue.empty()) {
+        const std::size_t i = queue.front();
+        queue.pop_front();
+        for (int m = 0; m < num_moves; ++m) {
+            const std::size_t n = next(i, m);
+            if (expected[n] == byte_table::unvisited) {
+                expected[n] = expected[i] + 1;
+                queue.push_back(n);
+            }
+        }
+    }
+
+    for (int threads : { 1, 3 }) {
+        const byte_table bytes = build_pruning_table(size, num_moves, next, generator_config{ threads });
+        const nibble_table nibbles = build_nibble_table(size, [&](std::size_t i, auto&& visit) {
+            for (int m = 0; m < num_moves; ++m) {
+                if (visit(next(i, m)))
+                { return; }
+            }
+        }, generator_config{ threads });
+        for (std::size_t i = 0; i < size; ++i) {
+            if (bytes.get(i) != expected[i] || nibbles.get(i) != expected[i]) {
+                os << "distance of index " << i << " differs from the reference with "
+                   << threads << " threads\n";
+                return 1;
+            }
+        }
+    }
+
+    /* 8! vertex-permutations fall into 2768 classes under the 16 U-D-symmetries. */
+    const auto perm_conjugation = build_conjugation_table<std::uint16_t>(coord::num_vertex_perms, num_ud_symmetries,
+        coord::set_vertex_perm, coord::vertex_perm);
+    const symmetry_classes classes = build_symmetry_classes(coord::num_vertex_perms, num_ud_symmetries, perm_conjugation);
+    if (classes.representatives.size() != 2768 || classes.class_of[0] != 0 || classes.stabilizers[0] != 0xffff)
+    { os << classes.representatives.size() << " classes of vertex-permutations instead of 2768\n"; return 1; }
+    for (coord::coord_t p = 0; p < coord::num_vertex_perms; ++p) {
+        const coord::coord_t rep = perm_conjugation[std::size_t(p) * num_ud_symmetries + classes.symmetry_of[p]];
+        if (rep != classes.representatives[classes.class_of[p]])
+        { os << "symmetry_of[" << p << "] does not lead to the representative of its class\n"; return 1; }
+    }
+
+    /*
+     * (ud-slice, edge-flip) fall into 64430 classes under the same symmetries. the flip of a
+     * conjugate is a function of the flip and the slice, however the other edges are placed.
+     */
+    auto flipslice = [](const cube& x) { return coord::ud_slice(x) * coord::num_edge_flips + coord::edge_flip(x); };
+    const symmetry_classes flipslices = build_symmetry_classes_by(coord::num_ud_slices * coord::num_edge_flips, num_ud_symmetries,
+        [&](coord::coord_t fs, int s) {
+            cube x = cube::get_solved();
+            coord::set_ud_slice(x, fs / coord::num_edge_flips);
+            coord::set_edge_flip(x, fs % coord::num_edge_flips);
+            return flipslice(conjugate(x, s));
+        });
+    if (flipslices.representatives.size() != 64430 || flipslices.class_of[0] != 0 || flipslices.stabilizers[0] != 0xffff)
+    { os << flipslices.representatives.size() << " classes of flipslices instead of 64430\n"; return 1; }
+    cube x = cube::get_solved();
+    std::uint64_t state = 0x9e3779b97f4a7c15ull;
+    for (int i = 0; i < 2000; ++i) {
+        state ^= state << 13; state ^= state >> 7; state ^= state << 17;
+        apply_move(x, move_t(state % num_moves));
+        const coord::coord_t fs = flipslice(x);
+        const int s = flipslices.symmetry_of[fs];
+        if (flipslice(conjugate(x, s)) != flipslices.representatives[flipslices.class_of[fs]])
+        { os << "symmetry_of does not lead a scrambled cube to the representative of its flipslice\n"; return 1; }
+    }
+
+    os << "tables_test passed\n";
+    return 0;
+}
+
+#endif
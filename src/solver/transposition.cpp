@@ -0,0 +1,137 @@
+#include <groubiks/solver/transposition.hpp>
+
+#include <algorithm>
+#include <bit>
+#include <vector>
+
+groubiks::solver::transposition_table::transposition_table(const config& cfg)
+    : m_policy(cfg.policy)
+{
+    const std::size_t num_buckets = std::bit_floor(std::max<std::size_t>(cfg.memory_bytes / sizeof(bucket), 1));
+    m_buckets = std::make_unique<bucket[]>(num_buckets);
+    m_mask = num_buckets - 1;
+}
+
+void groubiks::solver::transposition_table::clear() {
+    for (std::size_t i = 0; i <= m_mask; ++i) {
+        for (slot& s : m_buckets[i].slots)
+        { s.meta.store(0, std::memory_order_relaxed); }
+    }
+    for (counter* c : { &m_counters.probes, &m_counters.hits, &m_counters.stores, &m_counters.replacements, &m_counters.rejected })
+    { c->store(0, std::memory_order_relaxed); }
+}
+
+groubiks::solver::transposition_table::statistics groubiks::solver::transposition_table::stats() const {
+    statistics res;
+    res.probes = m_counters.probes.load(std::memory_order_relaxed);
+    res.hits = m_counters.hits.load(std::memory_order_relaxed);
+    res.stores = m_counters.stores.load(std::memory_order_relaxed);
+    res.replacements = m_counters.replacements.load(std::memory_order_relaxed);
+    res.rejected = m_counters.rejected.load(std::memory_order_relaxed);
+    return res;
+}
+
+#ifdef BUILD_TESTS
+
+/**
+ * @file transposition.cpp
+ * @brief transposition.hpp unit-test.
+ */
+
+#include <groubiks/cube/moves.hpp>
+#include <groubiks/solver/work_stealing.hpp>
+
+namespace {
+
+    using namespace groubiks;
+
+    /* the cubes along a random walk (repeats are harmless). */
+    std::vector<cube> random_states(std::size_t num, std::uint64_t seed) {
+        std::vector<cube> res(num);
+        cube c = cube::get_solved();
+        for (cube& s : res) {
+            seed ^= seed << 13; seed ^= seed >> 7; seed ^= seed << 17;
+            apply_move(c, move_t(seed % num_moves));
+            s = c;
+        }
+        return res;
+    }
+
+    /* the entry every thread stores for a state, so a torn write shows up as a wrong value. */
+    solver::transposition_table::entry entry_of(const cube& c)
+    { return { std::uint16_t(c.hash() >> 48), std::uint8_t(c.hash() >> 40 & 0x1f) }; }
+
+}
+
+int groubiks::solver::transposition_test(std::ostream& os) {
+    using replacement = transposition_table::replacement;
+
+    {
+        transposition_table table({ 1 << 20, replacement::depth_preferred });
+        if (table.bytes() != 1 << 20 || table.capacity() != 2 * (1 << 20) / 64)
+        { os << "transposition_table is not sized from its memory-budget\n"; return 1; }
+        transposition_table tiny({ 1, replacement::depth_preferred });
+        if (tiny.capacity() != 2)
+        { os << "a transposition_table below one bucket has no slots\n"; return 1; }
+
+        const cube solved = cube::get_solved();
+        if (table.probe(solved))
+        { os << "an empty transposition_table has an entry\n"; return 1; }
+        if (!table.store(solved, { 42, 3 }) || table.probe(solved) != transposition_table::entry{ 42, 3 })
+        { os << "transposition_table does not return a stored entry\n"; return 1; }
+        /* updating its own entry is never refused, not even with a smaller depth. */
+        if (!table.store(solved, { 7, 1 }) || table.probe(solved) != transposition_table::entry{ 7, 1 })
+        { os << "transposition_table does not update an entry\n"; return 1; }
+        const auto st = table.stats();
+        if (st.probes != 3 || st.hits != 2 || st.stores != 2 || st.replacements != 0)
+        { os << "transposition_table counts " << st.probes << " probes, " << st.hits << " hits\n"; return 1; }
+        table.clear();
+        if (table.probe(solved) || table.stats().probes != 1)
+        { os << "transposition_table::clear leaves entries\n"; return 1; }
+    }
+
+    /* a single bucket makes all states collide. */
+    for (replacement policy : { replacement::depth_preferred, replacement::always_replace }) {
+        transposition_table table({ 64, policy });
+        const cube states[] = { move_cubes[int(move_t::U)], move_cubes[int(move_t::R)],
+            move_cubes[int(move_t::F)], move_cubes[int(move_t::D)] };
+        table.store(states[0], { 0, 5 });
+        table.store(states[1], { 1, 2 });
+        /* the bucket is full, a shallower entry only gets in under always_replace. */
+        const bool stored = table.store(states[2], { 2, 1 });
+        if (stored != (policy == replacement::always_replace) || (table.probe(states[1]).has_value() == stored))
+        { os << "transposition_table replaced the wrong entry\n"; return 1; }
+        /* a deeper entry replaces the shallowest one under both policies. */
+        if (!table.store(states[3], { 3, 9 }) || !table.probe(states[0]) || !table.probe(states[3]))
+        { os << "transposition_table did not replace the shallowest entry\n"; return 1; }
+        if (table.stats().replacements != (stored ? 2u : 1u) || table.stats().rejected != (stored ? 0u : 1u))
+        { os << "transposition_table miscounts replacements\n"; return 1; }
+    }
+
+    /* many threads storing and probing a small table: every hit must be an entry stored for that state. */
+    {
+        constexpr int num_threads = 4;
+        transposition_table table({ 64 << 10, replacement::always_replace });
+        const std::vector<cube> states = random_states(1 << 14, 7);
+        std::atomic<int> wrong = 0;
+        run_workers(num_threads, [&](int w) {
+            for (int pass = 0; pass < 8; ++pass) {
+                for (std::size_t i = w; i < states.size(); i += num_threads) {
+                    table.store(states[i], entry_of(states[i]));
+                    const std::size_t j = (i * 7919 + pass) % states.size();
+                    const auto e = table.probe(states[j]);
+                    if (e && *e != entry_of(states[j]))
+                    { wrong.fetch_add(1, std::memory_order_relaxed); }
+                }
+            }
+        });
+        const auto st = table.stats();
+        if (wrong != 0 || st.hits == 0)
+        { os << "transposition_table returned " << wrong << " wrong entries in parallel\n"; return 1; }
+    }
+
+    os << "transposition_test passed\n";
+    return 0;
+}
+
+#endif
@@ -1,6 +1,14 @@
 
 #include <groubiks/utility/common.h>
 
+#if defined(__unix__) || defined(__APPLE__)
+    #define GROUBIKS_HAS_MMAP
+    #include <fcntl.h>
+    #include <sys/mman.h>
+    #include <sys/stat.h>
+    #include <unistd.h>
+#endif
+
 define_dynarray(uint32_t, u32);
 
 dynarray_result_t _copy_str(char** dest, const char** src) {
@@ -39,13 +47,14 @@ unsigned int clampui(unsigned int v, unsigned int lo, unsigned int hi) {
 
 int readFile(const char* path, char** ptr, size_t* size) {
     assert(path != NULL && ptr != NULL);
+    char* fdata = NULL;
     FILE* fstream = fopen(path, "rb");
     if (fstream == NULL)
     { goto error; }
     fseek(fstream, 0, SEEK_END);
     size_t fsize = ftell(fstream);
     fseek(fstream, 0, SEEK_SET);
-    char* fdata = malloc(sizeof(char) * fsize);
+    fdata = malloc(sizeof(char) * fsize);
     if (fdata == NULL)
     { goto error; }
     if (fread(fdata, sizeof(char), fsize, fstream) != fsize)
@@ -59,4 +68,44 @@ error:
     if (fstream != NULL)
     { fclose(fstream); }
     return -1;
-}
\ No newline at end of file
+}
+
+int mapFile(const char* path, const void** ptr, size_t* size) {
+    assert(path != NULL && ptr != NULL && size != NULL);
+#ifdef GROUBIKS_HAS_MMAP
+    int fd = open(path, O_RDONLY);
+    if (fd < 0)
+    { return -1; }
+    struct stat st;
+    if (fstat(fd, &st) != 0 || st.st_size <= 0) {
+        close(fd);
+        return -1;
+    }
+    void* data = mmap(NULL, (size_t)st.st_size, PROT_READ, MAP_SHARED, fd, 0);
+    /* the mapping stays valid after closing the descriptor. */
+    close(fd);
+    if (data == MAP_FAILED)
+    { return -1; }
+    *ptr = data;
+    *size = (size_t)st.st_size;
+    return 0;
+#else
+    char* data = NULL;
+    if (readFile(path, &data, size) != 0 || *size == 0) {
+        free(data);
+        return -1;
+    }
+    *ptr = data;
+    return 0;
+#endif
+}
+
+void unmapFile(const void* ptr, size_t size) {
+    if (ptr == NULL)
+    { return; }
+#ifdef GROUBIKS_HAS_MMAP
+    munmap((void*)ptr, size);
+#else
+    free((void*)ptr);
+#endif
+}
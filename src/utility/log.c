@@ -1,6 +1,19 @@
 
 #include <groubiks/utility/log.h>
 
+dynarray_result_t copy_log(log_t* dest, const log_t* src) {
+    assert(dest && src);
+    dest->m_fno = src->m_fno;
+    dest->m_prefix = strdup(src->m_prefix);
+    dest->m_use_timestamp = src->m_use_timestamp;
+    return dest->m_prefix == NULL ? DYNARRAY_ERROR : DYNARRAY_SUCCESS;
+}
+
+void free_log(log_t* ptr) {
+    assert(ptr);
+    free(ptr->m_prefix);
+}
+
 /* logs are not comparable. not an issue though as search-functions are not needed. */
 define_dynarray(log_t, log, 
     (copy, &copy_log), 
@@ -43,6 +56,11 @@ int log_init() {
 
 void log_end() {
     free_dynarray(log, &GROUBIKS_LOGS);
+    GROUBIKS_LOGS = null_dynarray(log);
+}
+
+int log_initialized() {
+    return GROUBIKS_LOGS.data != NULL;
 }
 
 int log_new(FILE* fno, const char* prefix, int use_timestamp) {